@@ -1,19 +1,127 @@
-/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes  
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
  *  @Authors
  *  Part 1: Design:
  *  - Driver: Anubhav Paras
  *  - Navigator: Charu Sharma
- * 
+ *
  *  Part 2: Implementation:
  *  - Driver: Shon Cortes
  *  - Navigator: Arunava Basu
 */
 
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
-int main() {
+#include <gain_update.hpp>
+#include <trace_replay.hpp>
+
+namespace {
+
+void print_usage(const char* program) {
+  std::cout
+      << "Usage: " << program << " replay [options] <input> <output>"
+      << " [<input> <output> ...]\n"
+      << "Replays (timestamp, setpoint, measured) logs through PID gains.\n"
+      << "Inputs are binary traces or csv files.\n"
+      << "Options:\n"
+      << "  --gains kP,kI,kD,max,min,dt  candidate gains, repeatable\n"
+      << "  --threads N                  logs replayed in parallel"
+      << " (default: one per core)\n"
+      << "  --csv                        write csv instead of binary output\n";
+}
+
+bool parse_gains(const std::string& text, GainSet* gains) {
+  std::istringstream in(text);
+  double values[6];
+  char comma;
+  for (int i = 0; i < 6; ++i) {
+    if (!(in >> values[i]) || (i < 5 && !(in >> comma && comma == ','))) {
+      return false;
+    }
+  }
+  gains->kP = values[0];
+  gains->kI = values[1];
+  gains->kD = values[2];
+  gains->max_value = values[3];
+  gains->min_value = values[4];
+  gains->dt = values[5];
+  return in.eof() || in.peek() == EOF;
+}
+
+int run_replay(int argc, char** argv) {
+  std::vector<GainSet> gain_sets;
+  std::vector<std::string> files;
+  unsigned threads = 0;
+  TraceFormat format = TraceFormat::binary;
+  for (int i = 2; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--gains") == 0 && i + 1 < argc) {
+      GainSet gains;
+      if (!parse_gains(argv[++i], &gains)) {
+        std::cerr << "Invalid --gains " << argv[i] << std::endl;
+        return 1;
+      }
+      gain_sets.push_back(gains);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--csv") == 0) {
+      format = TraceFormat::csv;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+  if (gain_sets.empty() || files.empty() || files.size() % 2 != 0) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<std::pair<std::string, std::string> > jobs;
+  for (std::size_t i = 0; i < files.size(); i += 2) {
+    jobs.emplace_back(files[i], files[i + 1]);
+  }
+
+  TraceReplayer replayer(gain_sets);
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::vector<uint64_t> counts = replayer.replay_all(jobs, format, threads);
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  uint64_t total = 0;
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    std::cout << jobs[i].first << " -> " << jobs[i].second << ": "
+              << counts[i] << " samples" << std::endl;
+    total += counts[i];
+  }
+  std::cout << total << " samples x " << gain_sets.size()
+            << " gain sets in " << seconds << " s" << std::endl;
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
     std::cout << "Welcome to PID Controller App."
               << "Please import the pid_lib library where you want to use it."
               << std::endl;
+    print_usage(argv[0]);
     return 0;
+  }
+  if (std::strcmp(argv[1], "replay") != 0) {
+    print_usage(argv[0]);
+    return 1;
+  }
+  try {
+    return run_replay(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
 }
@@ -0,0 +1,531 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <discrete_pid.hpp>
+#include <event_triggered.hpp>
+#include <frequency_response.hpp>
+#include <pid.hpp>
+#include <pid_bank.hpp>
+#include <plant.hpp>
+#include <robustness.hpp>
+#include <static_pid.hpp>
+
+/**
+ * @brief Self-contained micro benchmarks for the controller hot paths.
+ * Results are printed as JSON (to stdout or to --out <file>) so they can be
+ * stored and compared across releases. Build with
+ * -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+ *
+ * Usage: pid_bench [--out results.json] [--quick]
+ */
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Keeps the compiler from discarding a computed value
+ *
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile T sink;
+  sink = value;
+#endif
+}
+
+/**
+ * @brief One benchmark result; extra holds case-specific JSON fields
+ *
+ */
+struct Result {
+  std::string name;
+  uint64_t iterations;
+  double ns_per_op;
+  std::string extra;
+};
+
+double elapsed_ns(Clock::time_point start, Clock::time_point end) {
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count());
+}
+
+// Inputs cycle through a small table so the branch predictor and the
+// clamp see realistic, varying values.
+const std::size_t kInputCount = 1024;
+
+std::vector<double> make_inputs(double scale) {
+  std::vector<double> inputs(kInputCount);
+  for (std::size_t i = 0; i < kInputCount; ++i) {
+    inputs[i] = scale * static_cast<double>((i * 7919) % 200) / 100.0;
+  }
+  return inputs;
+}
+
+// Through the interface: the call cannot be devirtualized because the
+// pointer is laundered through a volatile.
+Result bench_compute_interface(uint64_t iterations) {
+  PIDController controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.001);
+  PIDControllerInterface* volatile laundered = &controller;
+  PIDControllerInterface* pid = laundered;
+  std::vector<double> measured = make_inputs(10.0);
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    do_not_optimize(pid->compute(10.0, measured[i % kInputCount]));
+  }
+  Clock::time_point end = Clock::now();
+  return {"compute/interface", iterations,
+          elapsed_ns(start, end) / static_cast<double>(iterations), ""};
+}
+
+Result bench_compute_direct(uint64_t iterations) {
+  PIDController controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.001);
+  std::vector<double> measured = make_inputs(10.0);
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    do_not_optimize(controller.compute(10.0, measured[i % kInputCount]));
+  }
+  Clock::time_point end = Clock::now();
+  return {"compute/direct", iterations,
+          elapsed_ns(start, end) / static_cast<double>(iterations), ""};
+}
+
+Result bench_compute_static(uint64_t iterations) {
+  StaticPIDController<double> controller(0.1, 0.1, 0.1, 100.0, -100.0,
+                                         0.001);
+  std::vector<double> measured = make_inputs(10.0);
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    do_not_optimize(controller.compute(10.0, measured[i % kInputCount]));
+  }
+  Clock::time_point end = Clock::now();
+  return {"compute/static", iterations,
+          elapsed_ns(start, end) / static_cast<double>(iterations), ""};
+}
+
+Result bench_compute_discrete(uint64_t iterations) {
+  DiscretePIDController controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.001);
+  controller.set_derivative_filter(0.01);
+  controller.set_anti_windup(AntiWindupMode::back_calculation);
+  std::vector<double> measured = make_inputs(10.0);
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    do_not_optimize(controller.compute(10.0, measured[i % kInputCount]));
+  }
+  Clock::time_point end = Clock::now();
+  return {"compute/discrete", iterations,
+          elapsed_ns(start, end) / static_cast<double>(iterations), ""};
+}
+
+Result bench_compute_float(uint64_t iterations) {
+  BasicPIDController<float> controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.001);
+  std::vector<float> measured(kInputCount);
+  std::vector<double> inputs = make_inputs(10.0);
+  std::copy(inputs.begin(), inputs.end(), measured.begin());
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    do_not_optimize(controller.compute_native(10.0f,
+                                              measured[i % kInputCount]));
+  }
+  Clock::time_point end = Clock::now();
+  return {"compute/float", iterations,
+          elapsed_ns(start, end) / static_cast<double>(iterations), ""};
+}
+
+Result bench_compute_q16_16(uint64_t iterations) {
+  BasicPIDController<Q16_16> controller(0.1, 0.1, 0.1, 100.0, -100.0,
+                                        0.001);
+  std::vector<Q16_16> measured;
+  for (double value : make_inputs(10.0)) {
+    measured.push_back(Q16_16(value));
+  }
+  const Q16_16 setpoint(10.0);
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    do_not_optimize(controller.compute_native(setpoint,
+                                              measured[i % kInputCount])
+                        .get_raw());
+  }
+  Clock::time_point end = Clock::now();
+  return {"compute/q16_16", iterations,
+          elapsed_ns(start, end) / static_cast<double>(iterations), ""};
+}
+
+Result bench_setters(uint64_t iterations) {
+  PIDController controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.001);
+  AbstractPIDController* volatile laundered = &controller;
+  AbstractPIDController* pid = laundered;
+  std::vector<double> values = make_inputs(1.0);
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    double v = values[i % kInputCount];
+    pid->set_kP(v);
+    pid->set_kI(v);
+    pid->set_kD(v);
+    pid->set_max_value(100.0 + v);
+    pid->set_min_value(-100.0 - v);
+    pid->set_dt(0.001 + v);
+  }
+  Clock::time_point end = Clock::now();
+  do_not_optimize(pid->get_kP());
+  // Six setter calls per iteration.
+  return {"setters/all_six", iterations,
+          elapsed_ns(start, end) / static_cast<double>(iterations * 6), ""};
+}
+
+// N heap-allocated controllers updated one by one through the interface,
+// the way a fleet of joints is driven today.
+Result bench_throughput_objects(std::size_t n, uint64_t total_updates) {
+  std::vector<std::unique_ptr<PIDControllerInterface> > controllers;
+  controllers.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    controllers.emplace_back(
+        new PIDController(0.1, 0.1, 0.1, 100.0, -100.0, 0.001));
+  }
+  std::vector<double> measured = make_inputs(10.0);
+  uint64_t ticks = std::max<uint64_t>(1, total_updates / n);
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t t = 0; t < ticks; ++t) {
+    for (std::size_t i = 0; i < n; ++i) {
+      do_not_optimize(controllers[i]->compute(
+          10.0, measured[(i + t) % kInputCount]));
+    }
+  }
+  Clock::time_point end = Clock::now();
+  uint64_t updates = ticks * n;
+  double ns = elapsed_ns(start, end) / static_cast<double>(updates);
+  std::ostringstream extra;
+  extra << "\"controllers\": " << n << ", \"working_set_bytes\": "
+        << n * sizeof(PIDController);
+  return {"throughput/objects/" + std::to_string(n), updates, ns,
+          extra.str()};
+}
+
+// Controllers near steady state: the measurement wanders by a small
+// fraction of the threshold, with a step on every 64th controller per tick.
+Result bench_throughput_event_triggered(std::size_t n,
+                                        uint64_t total_updates) {
+  GainSet gains = {0.1, 0.1, 0.1, 100.0, -100.0, 0.001};
+  EventTriggeredBatch batch;
+  for (std::size_t i = 0; i < n; ++i) {
+    batch.add(gains, 0.01, 0.1);
+  }
+  std::vector<double> setpoints(n, 10.0), measured(n, 9.0), out(n);
+  std::vector<std::size_t> changed(n);
+  std::vector<double> noise = make_inputs(0.001);
+  // The first tick always computes; run a few more to reach steady state.
+  uint64_t ticks = std::max<uint64_t>(8, total_updates / n);
+  uint64_t computed = 0;
+
+  Clock::time_point start = Clock::now();
+  for (uint64_t t = 0; t < ticks; ++t) {
+    for (std::size_t i = 0; i < n; ++i) {
+      measured[i] = 9.0 + noise[(i + t) % kInputCount] +
+                    ((i + t) % 64 == 0 ? 0.5 : 0.0);
+    }
+    computed += batch.update(0.001 * static_cast<double>(t),
+                             setpoints.data(), measured.data(), out.data(),
+                             changed.data());
+  }
+  Clock::time_point end = Clock::now();
+  uint64_t updates = ticks * n;
+  std::ostringstream extra;
+  extra << "\"controllers\": " << n << ", \"compute_fraction\": "
+        << static_cast<double>(computed) / static_cast<double>(updates);
+  return {"throughput/event_triggered/" + std::to_string(n), updates,
+          elapsed_ns(start, end) / static_cast<double>(updates),
+          extra.str()};
+}
+
+/**
+ * @brief A bank of n controllers with its input and output streams
+ *
+ */
+struct BankFixture {
+  explicit BankFixture(std::size_t n)
+      : bank(n), setpoints(n, 10.0), measured(n), out(n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      bank.add(0.1, 0.1, 0.1, 100.0, -100.0, 0.001);
+      measured[i] = static_cast<double>(i % 200) / 10.0;
+    }
+  }
+
+  void run(uint64_t ticks) {
+    const std::size_t n = bank.size();
+    for (uint64_t t = 0; t < ticks; ++t) {
+      bank.compute(setpoints.data(), measured.data(), out.data(), n);
+      do_not_optimize(out[t % n]);
+    }
+  }
+
+  PIDControllerBank bank;
+  std::vector<double> setpoints;
+  std::vector<double> measured;
+  std::vector<double> out;
+};
+
+Result bench_throughput_bank(std::size_t n, uint64_t total_updates) {
+  uint64_t ticks = std::max<uint64_t>(1, total_updates / n);
+  uint64_t updates = ticks * n;
+  BankFixture fixture(n);
+
+  Clock::time_point start = Clock::now();
+  fixture.run(ticks);
+  Clock::time_point end = Clock::now();
+  std::ostringstream extra;
+  // 9 state arrays plus setpoint, measured and output streams.
+  extra << "\"controllers\": " << n << ", \"working_set_bytes\": "
+        << n * 12 * sizeof(double);
+  return {"throughput/bank/" + std::to_string(n), updates,
+          elapsed_ns(start, end) / static_cast<double>(updates),
+          extra.str()};
+}
+
+// n controllers split into one bank per thread; ns_per_op is wall time
+// divided by all updates, so it drops as threads are added. Each thread
+// builds its own bank first so setup is not timed.
+Result bench_throughput_threads(std::size_t n, unsigned threads,
+                                uint64_t total_updates) {
+  std::size_t per_thread = std::max<std::size_t>(1, n / threads);
+  uint64_t ticks = std::max<uint64_t>(1, total_updates / n);
+  std::atomic<unsigned> ready(0);
+  std::atomic<bool> go(false);
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([per_thread, ticks, &ready, &go]() {
+      BankFixture fixture(per_thread);
+      ready.fetch_add(1);
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+      fixture.run(ticks);
+    });
+  }
+  while (ready.load() < threads) {
+    std::this_thread::yield();
+  }
+
+  Clock::time_point start = Clock::now();
+  go.store(true);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  Clock::time_point end = Clock::now();
+  uint64_t updates = ticks * per_thread * threads;
+  std::ostringstream extra;
+  extra << "\"controllers\": " << per_thread * threads
+        << ", \"threads\": " << threads;
+  return {"throughput/bank_threads/" + std::to_string(threads), updates,
+          elapsed_ns(start, end) / static_cast<double>(updates),
+          extra.str()};
+}
+
+// Monte Carlo robustness analysis of a PI loop on a first-order plant with
+// dead time, every parameter off by up to 30 %, on every core.
+Result bench_robustness(std::size_t samples) {
+  GainSet gains = {0.8, 1.5, 0.0, 100.0, -100.0, 0.01};
+  PlantDistribution plants =
+      uniform_spread(first_order_plant(1.0, 0.5, 0.05), 0.3);
+  RobustnessOptions options;
+  options.samples = samples;
+  Clock::time_point start = Clock::now();
+  RobustnessReport report = analyze_robustness(gains, plants, options);
+  Clock::time_point end = Clock::now();
+  std::ostringstream extra;
+  extra << "\"steps\": " << options.simulation.steps
+        << ", \"stability_rate\": " << report.get_stability_rate()
+        << ", \"settled_rate\": " << report.get_settled_rate()
+        << ", \"p99_overshoot\": " << report.overshoot.get_percentile(0.99)
+        << ", \"p99_settling_time\": "
+        << report.settling_time.get_percentile(0.99);
+  return {"robustness/samples", samples,
+          elapsed_ns(start, end) / static_cast<double>(samples),
+          extra.str()};
+}
+
+// Stability margins of n PID configurations on a second-order plant with
+// dead time, 2048 frequencies each, on every core.
+Result bench_frequency_margins(std::size_t n) {
+  FrequencyAnalyzer analyzer;
+  for (std::size_t i = 0; i < n; ++i) {
+    double scale = 0.2 + 0.8 * static_cast<double>(i) / static_cast<double>(n);
+    GainSet gains = {1.2 * scale, 2.0 * scale, 0.01 * scale, 100.0, -100.0,
+                     0.01};
+    analyzer.add(gains, second_order_plant(1.0, 5.0, 0.4, 0.03));
+  }
+  Clock::time_point start = Clock::now();
+  std::vector<StabilityMargins> margins = analyzer.analyze();
+  Clock::time_point end = Clock::now();
+  std::ostringstream extra;
+  extra << "\"frequencies\": " << analyzer.get_response(0).frequency.size()
+        << ", \"median_phase_margin\": " << margins[n / 2].phase_margin;
+  return {"frequency/margins", n,
+          elapsed_ns(start, end) / static_cast<double>(n), extra.str()};
+}
+
+// Times every call individually. The reported values include the
+// overhead of one steady_clock read, reported as timer_overhead_ns.
+Result bench_tail_latency(uint64_t samples) {
+  PIDController controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.001);
+  PIDControllerInterface* volatile laundered = &controller;
+  PIDControllerInterface* pid = laundered;
+  std::vector<double> measured = make_inputs(10.0);
+  std::vector<double> latencies(samples);
+
+  Clock::time_point overhead_start = Clock::now();
+  for (uint64_t i = 0; i < samples; ++i) {
+    do_not_optimize(Clock::now());
+  }
+  double timer_overhead = elapsed_ns(overhead_start, Clock::now()) /
+                          static_cast<double>(samples);
+
+  Clock::time_point previous = Clock::now();
+  for (uint64_t i = 0; i < samples; ++i) {
+    do_not_optimize(pid->compute(10.0, measured[i % kInputCount]));
+    Clock::time_point now = Clock::now();
+    latencies[i] = elapsed_ns(previous, now);
+    previous = now;
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  double sum = 0;
+  for (double latency : latencies) {
+    sum += latency;
+  }
+  const double percentiles[] = {50.0, 90.0, 99.0, 99.9, 99.99};
+  std::ostringstream extra;
+  extra << "\"timer_overhead_ns\": " << timer_overhead;
+  for (double p : percentiles) {
+    std::size_t index = static_cast<std::size_t>(
+        p / 100.0 * static_cast<double>(samples - 1));
+    std::string key = std::to_string(p);
+    key.erase(key.find_last_not_of('0') + 1);
+    if (key.back() == '.') {
+      key.pop_back();
+    }
+    extra << ", \"p" << key << "_ns\": " << latencies[index];
+  }
+  extra << ", \"max_ns\": " << latencies.back();
+  return {"latency/compute", samples, sum / static_cast<double>(samples),
+          extra.str()};
+}
+
+std::string to_json(const std::vector<Result>& results, bool quick) {
+  std::ostringstream json;
+  json << "{\n  \"context\": {\n"
+       << "    \"hardware_concurrency\": "
+       << std::thread::hardware_concurrency() << ",\n"
+       << "    \"bank_kernel\": "
+       << static_cast<int>(PIDControllerBank::best_kernel()) << ",\n"
+       << "    \"quick\": " << (quick ? "true" : "false") << "\n"
+       << "  },\n  \"benchmarks\": [\n";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    json << "    {\"name\": \"" << r.name << "\", \"iterations\": "
+         << r.iterations << ", \"ns_per_op\": " << r.ns_per_op
+         << ", \"ops_per_sec\": "
+         << (r.ns_per_op > 0 ? 1e9 / r.ns_per_op : 0.0);
+    if (!r.extra.empty()) {
+      json << ", " << r.extra;
+    }
+    json << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  json << "  ]\n}\n";
+  return json.str();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string out_path;
+  bool quick = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+      out_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--quick") == 0) {
+      quick = true;
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--out results.json] [--quick]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  const uint64_t single_iterations = quick ? 200000 : 20000000;
+  const uint64_t total_updates = quick ? 1000000 : 100000000;
+  const uint64_t latency_samples = quick ? 100000 : 1000000;
+  const std::size_t robustness_samples = quick ? 4096 : 100000;
+  const std::size_t frequency_configurations = quick ? 1024 : 16384;
+  // 1K and 16K controllers stay in cache, 1M spills to DRAM.
+  const std::size_t sizes[] = {1024, 16384, 1048576};
+
+  std::vector<Result> results;
+  results.push_back(bench_compute_interface(single_iterations));
+  results.push_back(bench_compute_direct(single_iterations));
+  results.push_back(bench_compute_static(single_iterations));
+  results.push_back(bench_compute_discrete(single_iterations));
+  results.push_back(bench_compute_float(single_iterations));
+  results.push_back(bench_compute_q16_16(single_iterations));
+  results.push_back(bench_setters(single_iterations));
+  for (std::size_t n : sizes) {
+    results.push_back(bench_throughput_objects(n, total_updates));
+    results.push_back(bench_throughput_bank(n, total_updates));
+    results.push_back(bench_throughput_event_triggered(n, total_updates));
+  }
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+    results.push_back(
+        bench_throughput_threads(sizes[2], threads, total_updates));
+  }
+  results.push_back(bench_tail_latency(latency_samples));
+  results.push_back(bench_robustness(robustness_samples));
+  results.push_back(bench_frequency_margins(frequency_configurations));
+
+  std::string json = to_json(results, quick);
+  if (out_path.empty()) {
+    std::cout << json;
+  } else {
+    std::ofstream out(out_path.c_str());
+    if (!out) {
+      std::cerr << "Cannot open " << out_path << std::endl;
+      return 1;
+    }
+    out << json;
+  }
+  return 0;
+}
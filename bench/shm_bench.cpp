@@ -0,0 +1,293 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pid.hpp>
+#include <shm_controller.hpp>
+
+/**
+ * @brief Round-trip latency of one remote compute() from another process:
+ * through a ShmControllerServer, and through a local TCP and a Unix domain
+ * socket server as the baseline. The server always runs in a forked child.
+ * Results are printed as JSON, like pid_bench.
+ *
+ * Usage: shm_bench [--out results.json] [--quick] [--spin N]
+ */
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const double kGains[6] = {0.1, 0.1, 0.1, 100.0, -100.0, 0.001};
+
+struct Request {
+  double setpoint;
+  double measured;
+};
+
+double elapsed_ns(Clock::time_point start, Clock::time_point end) {
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count());
+}
+
+bool read_all(int fd, void* data, std::size_t size) {
+  char* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, bytes, size);
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+bool write_all(int fd, const void* data, std::size_t size) {
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t n = write(fd, bytes, size);
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+// Socket server of the baseline: one request in, one output out, until the
+// client hangs up.
+void serve_socket(int fd) {
+  PIDController controller(kGains[0], kGains[1], kGains[2], kGains[3],
+                           kGains[4], kGains[5]);
+  Request request;
+  while (read_all(fd, &request, sizeof(request))) {
+    double output = controller.compute(request.setpoint, request.measured);
+    if (!write_all(fd, &output, sizeof(output))) {
+      break;
+    }
+  }
+  close(fd);
+}
+
+std::string summarize(std::vector<double>* latencies) {
+  std::sort(latencies->begin(), latencies->end());
+  const double percentiles[] = {50.0, 99.0, 99.9};
+  const char* keys[] = {"p50_ns", "p99_ns", "p99.9_ns"};
+  std::ostringstream extra;
+  for (int i = 0; i < 3; ++i) {
+    std::size_t index = static_cast<std::size_t>(
+        percentiles[i] / 100.0 * static_cast<double>(latencies->size() - 1));
+    extra << (i > 0 ? ", " : "") << "\"" << keys[i]
+          << "\": " << (*latencies)[index];
+  }
+  extra << ", \"max_ns\": " << latencies->back();
+  return extra.str();
+}
+
+struct Result {
+  std::string name;
+  uint64_t iterations;
+  double ns_per_op;
+  std::string extra;
+};
+
+Result measure(const std::string& name, uint64_t samples, int fd) {
+  std::vector<double> latencies(samples);
+  double sum = 0;
+  for (uint64_t i = 0; i < samples; ++i) {
+    Request request = {10.0, static_cast<double>(i % 200) / 20.0};
+    double output;
+    Clock::time_point start = Clock::now();
+    if (!write_all(fd, &request, sizeof(request)) ||
+        !read_all(fd, &output, sizeof(output))) {
+      throw std::runtime_error(name + ": connection lost");
+    }
+    latencies[i] = elapsed_ns(start, Clock::now());
+    sum += latencies[i];
+  }
+  return {name, samples, sum / static_cast<double>(samples),
+          summarize(&latencies)};
+}
+
+Result bench_unix_socket(uint64_t samples) {
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+    throw std::runtime_error("socketpair failed");
+  }
+  pid_t child = fork();
+  if (child == 0) {
+    close(fds[0]);
+    serve_socket(fds[1]);
+    _exit(0);
+  }
+  close(fds[1]);
+  Result result = measure("roundtrip/unix_socket", samples, fds[0]);
+  close(fds[0]);
+  waitpid(child, nullptr, 0);
+  return result;
+}
+
+Result bench_tcp_loopback(uint64_t samples) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  socklen_t length = sizeof(address);
+  if (listener < 0 ||
+      bind(listener, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+      listen(listener, 1) != 0 ||
+      getsockname(listener, reinterpret_cast<sockaddr*>(&address),
+                  &length) != 0) {
+    throw std::runtime_error("cannot listen on the loopback interface");
+  }
+  pid_t child = fork();
+  if (child == 0) {
+    int connection = accept(listener, nullptr, nullptr);
+    close(listener);
+    int one = 1;
+    setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    serve_socket(connection);
+    _exit(0);
+  }
+  close(listener);
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&address), length) != 0) {
+    throw std::runtime_error("cannot connect to the loopback server");
+  }
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  Result result = measure("roundtrip/tcp_loopback", samples, fd);
+  close(fd);
+  waitpid(child, nullptr, 0);
+  return result;
+}
+
+Result bench_shm(uint64_t samples, unsigned spin) {
+  std::string name = "/pid_shm_bench_" + std::to_string(getpid());
+  GainSet gains = {kGains[0], kGains[1], kGains[2], kGains[3], kGains[4],
+                   kGains[5]};
+  ShmControllerServer server(name, std::vector<GainSet>(1, gains));
+  server.set_spin(spin);
+  pid_t child = fork();
+  if (child == 0) {
+    server.serve();
+    _exit(0);
+  }
+  std::vector<double> latencies(samples);
+  double sum = 0;
+  {
+    ShmControllerClient client(name, 0);
+    client.set_spin(spin);
+    for (uint64_t i = 0; i < samples; ++i) {
+      double measured = static_cast<double>(i % 200) / 20.0;
+      Clock::time_point start = Clock::now();
+      client.compute(10.0, measured);
+      latencies[i] = elapsed_ns(start, Clock::now());
+      sum += latencies[i];
+    }
+  }
+  // Stops the child's serve() loop through the shared segment.
+  server.stop();
+  waitpid(child, nullptr, 0);
+  std::ostringstream extra;
+  extra << "\"spin\": " << spin << ", " << summarize(&latencies);
+  return {"roundtrip/shm", samples, sum / static_cast<double>(samples),
+          extra.str()};
+}
+
+std::string to_json(const std::vector<Result>& results, bool quick) {
+  std::ostringstream json;
+  json << "{\n  \"context\": {\n"
+       << "    \"hardware_concurrency\": "
+       << std::thread::hardware_concurrency() << ",\n"
+       << "    \"quick\": " << (quick ? "true" : "false") << "\n"
+       << "  },\n  \"benchmarks\": [\n";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    json << "    {\"name\": \"" << r.name << "\", \"iterations\": "
+         << r.iterations << ", \"ns_per_op\": " << r.ns_per_op
+         << ", \"ops_per_sec\": "
+         << (r.ns_per_op > 0 ? 1e9 / r.ns_per_op : 0.0) << ", " << r.extra
+         << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  json << "  ]\n}\n";
+  return json.str();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string out_path;
+  bool quick = false;
+  // Spinning only pays off when client and server have a core each.
+  unsigned spin = std::thread::hardware_concurrency() > 1 ? 20000 : 0;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+      out_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--quick") == 0) {
+      quick = true;
+    } else if (std::strcmp(argv[i], "--spin") == 0 && i + 1 < argc) {
+      spin = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--out results.json] [--quick] [--spin N]" << std::endl;
+      return 1;
+    }
+  }
+
+  const uint64_t samples = quick ? 20000 : 1000000;
+  std::vector<Result> results;
+  try {
+    results.push_back(bench_shm(samples, spin));
+    results.push_back(bench_unix_socket(samples));
+    results.push_back(bench_tcp_loopback(samples));
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 1;
+  }
+
+  std::string json = to_json(results, quick);
+  if (out_path.empty()) {
+    std::cout << json;
+  } else {
+    std::ofstream out(out_path.c_str());
+    if (!out) {
+      std::cerr << "Cannot open " << out_path << std::endl;
+      return 1;
+    }
+    out << json;
+  }
+  return 0;
+}
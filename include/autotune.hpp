@@ -0,0 +1,153 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_AUTOTUNE_HPP_
+#define INCLUDE_AUTOTUNE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gain_update.hpp>
+#include <plant.hpp>
+#include <simulation.hpp>
+#include <trace_replay.hpp>
+
+/**
+ * @brief Settings of a relay feedback experiment
+ *
+ */
+struct RelayOptions {
+  double amplitude = 1.0;   // relay output is +amplitude or -amplitude
+  double hysteresis = 0.0;  // error band in which the relay keeps state
+  std::size_t max_steps = 100000;
+  unsigned cycles = 4;      // oscillation periods averaged
+};
+
+/**
+ * @brief Outcome of a relay feedback experiment
+ *
+ */
+struct RelayResult {
+  double ultimate_gain;
+  double ultimate_period;  // seconds
+  bool oscillated;         // false if no steady oscillation was found
+};
+
+/**
+ * @brief Run a relay feedback experiment (Astrom-Hagglund) on a plant and
+ * estimate its ultimate gain 4 amplitude / (pi a) and ultimate period from
+ * the limit cycle.
+ *
+ * @param plant plant description
+ * @param dt sampling time, > 0
+ * @param options relay settings
+ * @return RelayResult
+ */
+RelayResult relay_test(const PlantParams& plant, double dt,
+                       const RelayOptions& options = RelayOptions());
+
+/**
+ * @brief Classic Ziegler-Nichols PID gains from the ultimate gain and
+ * period: kP = 0.6 Ku, kI = 1.2 Ku / Pu, kD = 0.075 Ku Pu
+ *
+ * @param ultimate_gain Ku
+ * @param ultimate_period Pu in seconds
+ * @param max_value upper output limit
+ * @param min_value lower output limit
+ * @param dt sampling time
+ * @return GainSet
+ */
+GainSet ziegler_nichols_gains(double ultimate_gain, double ultimate_period,
+                              double max_value, double min_value, double dt);
+
+/**
+ * @brief Fit a first-order-plus-dead-time plant to an open-loop step test
+ * with the two-point (28.3 % / 63.2 %) method. The setpoint column holds the
+ * actuator input, which must step once; the measured column holds the
+ * plant output. Throws std::invalid_argument if no step response is found.
+ *
+ * @param step_test recorded samples, timestamps increasing
+ * @return PlantParams
+ */
+PlantParams fit_first_order_plant(const std::vector<TraceSample>& step_test);
+
+/**
+ * @brief Settings of a tuning run
+ *
+ */
+struct TuningOptions {
+  SimulationOptions simulation;    // step-response experiment per candidate
+  double overshoot_weight = 0.0;   // cost = IAE + weight * overshoot / 100
+  double max_value = 100.0;        // output limits of the tuned controller
+  double min_value = -100.0;
+  unsigned starts = 8;             // Nelder-Mead searches, run in parallel
+  unsigned max_evaluations = 300;  // per search
+  double tolerance = 1e-6;         // relative cost spread at convergence
+  unsigned threads = 0;            // 0 for one per core
+  RelayOptions relay;
+
+  TuningOptions() {
+    // Candidates ten times past the setpoint are clearly unstable.
+    simulation.divergence_limit = 10.0;
+  }
+};
+
+/**
+ * @brief Outcome of a tuning run
+ *
+ */
+struct TuningResult {
+  GainSet gains;                // best gains found
+  GainSet initial_gains;        // relay / Ziegler-Nichols starting point
+  double cost;
+  StepResponseMetrics metrics;  // step response of the best gains
+  uint64_t evaluations;         // candidates simulated
+  uint64_t rejected;            // candidates cut off as unstable
+};
+
+/**
+ * @brief Tune PID gains against a plant model.
+ *
+ * A relay experiment gives Ziegler-Nichols starting gains. Then
+ * options.starts Nelder-Mead searches over log(kP), log(kI), log(kD), the
+ * first from the Ziegler-Nichols point and the others from deterministic
+ * perturbations of it, run in parallel. Every search owns one
+ * PIDController and one DiscretePlant, updates the controller through
+ * set_kP/set_kI/set_kD and resets both between candidates, so evaluations
+ * do not allocate. Unstable candidates stop as soon as they exceed the
+ * divergence limit. The result does not depend on the thread count.
+ *
+ * The search runs over the gain magnitudes. For a reverse-acting plant
+ * (gain < 0) every gain, including the Ziegler-Nichols starting point, takes
+ * the negative sign so the loop stays negative feedback.
+ *
+ * @param plant plant description
+ * @param dt controller sampling time, > 0
+ * @param options tuning settings
+ * @return TuningResult
+ */
+TuningResult tune_gains(const PlantParams& plant, double dt,
+                        const TuningOptions& options = TuningOptions());
+
+/**
+ * @brief Tune PID gains against a recorded open-loop step test by fitting
+ * a first-order-plus-dead-time model first
+ *
+ * @param step_test recorded samples, see fit_first_order_plant()
+ * @param dt controller sampling time, > 0
+ * @param options tuning settings
+ * @return TuningResult
+ */
+TuningResult tune_gains(const std::vector<TraceSample>& step_test, double dt,
+                        const TuningOptions& options = TuningOptions());
+
+#endif  // INCLUDE_AUTOTUNE_HPP_
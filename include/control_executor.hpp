@@ -0,0 +1,139 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_CONTROL_EXECUTOR_HPP_
+#define INCLUDE_CONTROL_EXECUTOR_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <pid.hpp>
+
+/**
+ * @brief Timing statistics of one control loop
+ *
+ */
+struct LoopStats {
+  uint64_t ticks;             // completed compute() ticks
+  uint64_t overruns;          // ticks that finished after the next deadline
+  uint64_t missed_deadlines;  // deadlines skipped because of an overrun
+  uint64_t stolen;            // ticks run by a worker that does not own it
+  double mean_jitter_ns;      // mean delay between deadline and tick start
+  double max_jitter_ns;       // worst delay between deadline and tick start
+};
+
+/**
+ * @brief Runs many fixed-rate control loops on a few pinned worker threads.
+ *
+ * Each loop is a controller plus three callbacks (setpoint, measurement and
+ * actuator) and ticks every get_dt() seconds at absolute deadlines, so
+ * timing errors do not accumulate. Loops are spread over the workers by
+ * rate at start(); a worker with nothing due steals loops that another
+ * worker has left overdue. Loops are registered before start().
+ *
+ */
+class ControlExecutor {
+ public:
+  typedef std::function<double()> SignalSource;
+  typedef std::function<void(double)> Actuator;
+
+  /**
+   * @brief Construct a new ControlExecutor object
+   *
+   * @param worker_count number of worker threads, at least 1
+   * @param cpus core each worker is pinned to (worker i uses
+   *        cpus[i % cpus.size()]); empty pins worker i to core i modulo the
+   *        number of cores
+   * @param steal_after_ns how long a loop must be overdue before another
+   *        worker may steal it
+   */
+  explicit ControlExecutor(unsigned worker_count,
+                           const std::vector<int>& cpus = std::vector<int>(),
+                           int64_t steal_after_ns = 100000);
+
+  /**
+   * @brief Destroy the ControlExecutor object. Stops the workers.
+   *
+   */
+  ~ControlExecutor();
+
+  ControlExecutor(const ControlExecutor&) = delete;
+  ControlExecutor& operator=(const ControlExecutor&) = delete;
+
+  /**
+   * @brief Register a loop. Its period is controller->get_dt() at the time
+   * of the call.
+   *
+   * @param controller controller to tick, must outlive the executor
+   * @param setpoint called once per tick for the target value
+   * @param measurement called once per tick for the measured value
+   * @param actuator receives the controller output of every tick
+   * @return std::size_t index of the loop, for get_stats()
+   */
+  std::size_t add_loop(AbstractPIDController* controller,
+                       SignalSource setpoint, SignalSource measurement,
+                       Actuator actuator);
+
+  /**
+   * @brief Assign the loops to workers and start ticking
+   *
+   */
+  void start();
+
+  /**
+   * @brief Stop ticking and join the workers
+   *
+   */
+  void stop();
+
+  /**
+   * @brief Get the timing statistics of a loop. Safe while running.
+   *
+   * @param loop index returned by add_loop()
+   * @return LoopStats
+   */
+  LoopStats get_stats(std::size_t loop) const;
+
+  /**
+   * @brief Get the number of registered loops
+   *
+   * @return std::size_t
+   */
+  std::size_t get_loop_count() const;
+
+  /**
+   * @brief Get the number of worker threads
+   *
+   * @return unsigned
+   */
+  unsigned get_worker_count() const;
+
+ private:
+  struct Loop;
+
+  void run_worker(unsigned worker);
+  bool run_tick(Loop* loop, unsigned worker, int64_t now_ns);
+
+  unsigned worker_count;
+  std::vector<int> cpus;
+  int64_t steal_after_ns;
+  std::vector<std::unique_ptr<Loop> > loops;
+  std::vector<std::vector<Loop*> > assignments;
+  std::vector<std::thread> workers;
+  std::atomic<bool> running;
+};
+
+#endif  // INCLUDE_CONTROL_EXECUTOR_HPP_
@@ -0,0 +1,240 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_CONTROLLER_GRAPH_HPP_
+#define INCLUDE_CONTROLLER_GRAPH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gain_update.hpp>
+
+/**
+ * @brief Cascade and feedforward structure evaluated as one flat pass.
+ *
+ * Nodes and edges are declared once, then compile() sorts the nodes
+ * topologically and lays them out in one contiguous array, with the edges
+ * feeding each node stored next to each other. tick() walks that array
+ * once: every node sums its weighted input edges per port and evaluates
+ * itself through a switch, so there are no virtual calls and no
+ * allocation. PID nodes use the same arithmetic as PIDController and give
+ * bit-identical outputs.
+ *
+ * A node with decimation N is evaluated on ticks 0, N, 2N, ... and holds
+ * its output in between, which runs outer loops slower than inner ones;
+ * the dt of a decimated PID node should be N times the tick period.
+ *
+ */
+class ControllerGraph {
+ public:
+  typedef std::size_t NodeId;
+
+  /**
+   * @brief Construct an empty ControllerGraph
+   *
+   */
+  ControllerGraph();
+
+  /**
+   * @brief Input port of a node. PID nodes have setpoint and measured,
+   * every other node has input. Several edges into one port are summed.
+   *
+   */
+  enum class Port {
+    input,
+    setpoint,
+    measured
+  };
+
+  /**
+   * @brief Add an external signal, written with set_input() before a tick
+   *
+   * @return NodeId
+   */
+  NodeId add_input();
+
+  /**
+   * @brief Add a PID controller, output = PIDController::compute(setpoint,
+   * measured)
+   *
+   * @param gains gains, limits and sampling time, gains.dt > 0
+   * @param decimation evaluate every decimation ticks, > 0
+   * @return NodeId
+   */
+  NodeId add_pid(const GainSet& gains, unsigned decimation = 1);
+
+  /**
+   * @brief Add a static gain, output = gain * input
+   *
+   * @param gain multiplier
+   * @param decimation evaluate every decimation ticks, > 0
+   * @return NodeId
+   */
+  NodeId add_gain(double gain, unsigned decimation = 1);
+
+  /**
+   * @brief Add a summing junction, output = input. Use edge weights for
+   * signs, e.g. 1 and -1 for a difference.
+   *
+   * @param decimation evaluate every decimation ticks, > 0
+   * @return NodeId
+   */
+  NodeId add_sum(unsigned decimation = 1);
+
+  /**
+   * @brief Add a feedforward term, output = gain * input + rate_gain *
+   * (input - previous input) / dt
+   *
+   * @param gain static feedforward gain
+   * @param rate_gain feedforward gain on the input rate
+   * @param dt time between evaluations of this node, > 0
+   * @param decimation evaluate every decimation ticks, > 0
+   * @return NodeId
+   */
+  NodeId add_feedforward(double gain, double rate_gain, double dt,
+                         unsigned decimation = 1);
+
+  /**
+   * @brief Add a limiter, output = input clamped to [min_value, max_value]
+   *
+   * @param min_value lower limit
+   * @param max_value upper limit, >= min_value
+   * @param decimation evaluate every decimation ticks, > 0
+   * @return NodeId
+   */
+  NodeId add_limiter(double min_value, double max_value,
+                     unsigned decimation = 1);
+
+  /**
+   * @brief Feed weight * output of from into a port of to. Throws
+   * std::out_of_range for unknown nodes and std::invalid_argument for a
+   * port the node does not have or an edge into an input node.
+   *
+   * @param from source node
+   * @param to destination node
+   * @param port port of the destination
+   * @param weight multiplier applied to the source output
+   */
+  void connect(NodeId from, NodeId to, Port port = Port::input,
+               double weight = 1.0);
+
+  /**
+   * @brief Lay the graph out for evaluation and clear all state. Throws
+   * std::invalid_argument if the edges form a cycle. Adding nodes or edges
+   * afterwards requires another compile().
+   *
+   */
+  void compile();
+
+  /**
+   * @brief Check whether tick() can be called
+   *
+   * @return bool
+   */
+  bool is_compiled() const;
+
+  /**
+   * @brief Set the value of an input node for the next ticks
+   *
+   * @param input node created by add_input()
+   * @param value signal value
+   */
+  void set_input(NodeId input, double value);
+
+  /**
+   * @brief Evaluate every due node once, in topological order. Throws
+   * std::logic_error if the graph is not compiled.
+   *
+   */
+  void tick();
+
+  /**
+   * @brief Get the latest output of a node
+   *
+   * @param node any node
+   * @return double
+   */
+  double get_output(NodeId node) const;
+
+  /**
+   * @brief Clear PID, feedforward and decimation state and all outputs
+   * except the inputs
+   *
+   */
+  void reset();
+
+  /**
+   * @brief Get the number of nodes
+   *
+   * @return std::size_t
+   */
+  std::size_t get_node_count() const;
+
+ private:
+  enum class Kind : uint8_t {
+    input,
+    pid,
+    gain,
+    sum,
+    feedforward,
+    limiter
+  };
+
+  /**
+   * @brief Node in the compiled array. Parameters and state of every kind
+   * share the same fields to keep the array uniform:
+   *   pid:         param = kP, kI, kD / dt, max, min, dt;
+   *                state = integral_sum, prev_error
+   *   gain:        param[0] = gain
+   *   feedforward: param = gain, rate_gain / dt; state[0] = previous input
+   *   limiter:     param = min, max
+   *
+   */
+  struct Node {
+    Kind kind;
+    uint32_t decimation;
+    uint32_t countdown;
+    uint32_t edge_begin;
+    uint32_t edge_end;
+    double param[6];
+    double state[2];
+  };
+
+  struct Edge {
+    uint32_t source;  // slot of the source in the compiled array
+    uint32_t port;    // 0 = input or setpoint, 1 = measured
+    double weight;
+  };
+
+  struct Link {
+    NodeId from;
+    NodeId to;
+    Port port;
+    double weight;
+  };
+
+  NodeId add_node(Kind kind, unsigned decimation);
+  void check_node(NodeId node) const;
+
+  // Declared graph, in NodeId order.
+  std::vector<Node> declared;
+  std::vector<Link> links;
+
+  // Compiled graph, in topological order.
+  bool compiled;
+  std::vector<Node> nodes;
+  std::vector<Edge> edges;
+  std::vector<double> outputs;
+  std::vector<uint32_t> slot_of;
+};
+
+#endif  // INCLUDE_CONTROLLER_GRAPH_HPP_
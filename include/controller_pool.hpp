@@ -0,0 +1,118 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_CONTROLLER_POOL_HPP_
+#define INCLUDE_CONTROLLER_POOL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <gain_update.hpp>
+#include <pid.hpp>
+#include <pid_status.hpp>
+
+/**
+ * @brief Fixed-capacity pool of PIDControllers for real-time threads.
+ * reserve() allocates one page-aligned arena up front, optionally locked
+ * into RAM with mlock(); after that create() and destroy() only
+ * placement-construct into and release its cache-line-aligned slots, so
+ * they never touch the heap, never page fault and never throw. Every
+ * member is noexcept and reports errors as PIDStatus.
+ *
+ * Not thread-safe: one thread owns the pool, and controllers are used from
+ * one thread at a time like any PIDController.
+ *
+ */
+class ControllerPool {
+ public:
+  /**
+   * @brief Construct an empty pool; call reserve() before create()
+   *
+   */
+  ControllerPool() noexcept;
+
+  /**
+   * @brief Destroy the live controllers and release the arena
+   *
+   */
+  ~ControllerPool();
+
+  ControllerPool(const ControllerPool&) = delete;
+  ControllerPool& operator=(const ControllerPool&) = delete;
+
+  /**
+   * @brief Allocate the arena for capacity controllers, replacing any
+   * previous one. Call it at startup, outside the real-time loop. On error
+   * the pool is left empty.
+   *
+   * @param capacity number of slots, > 0
+   * @param lock_memory mlock() the arena so it is never paged out
+   * @return PIDStatus PIDStatus::in_use if controllers are still alive,
+   * PIDStatus::lock_failed if mlock() failed (e.g. RLIMIT_MEMLOCK)
+   */
+  PIDStatus reserve(std::size_t capacity, bool lock_memory) noexcept;
+
+  /**
+   * @brief Construct a controller in a free slot
+   *
+   * @param gains gains, limits and sampling time
+   * @return PIDResult<PIDController*> the controller, or
+   * PIDStatus::invalid_dt / PIDStatus::pool_exhausted
+   */
+  PIDResult<PIDController*> create(const GainSet& gains) noexcept;
+
+  /**
+   * @brief Destroy a controller and free its slot
+   *
+   * @param controller a live controller returned by create()
+   * @return PIDStatus PIDStatus::invalid_argument if the pool did not
+   * create it or it was already destroyed
+   */
+  PIDStatus destroy(PIDController* controller) noexcept;
+
+  /**
+   * @brief Get the number of live controllers
+   *
+   * @return std::size_t
+   */
+  std::size_t size() const noexcept;
+
+  /**
+   * @brief Get the number of slots
+   *
+   * @return std::size_t
+   */
+  std::size_t capacity() const noexcept;
+
+  /**
+   * @brief Check whether the arena is locked into RAM
+   *
+   * @return bool
+   */
+  bool is_locked() const noexcept;
+
+ private:
+  /**
+   * @brief Destroy the live controllers and free the arena
+   *
+   */
+  void release() noexcept;
+
+  unsigned char* arena;
+  std::size_t arena_bytes;
+  uint32_t* next_free;  // per slot: next free slot, or kAllocated
+  std::size_t slot_count;
+  std::size_t live;
+  uint32_t free_head;
+  bool locked;
+};
+
+#endif  // INCLUDE_CONTROLLER_POOL_HPP_
@@ -0,0 +1,209 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_DISCRETE_PID_HPP_
+#define INCLUDE_DISCRETE_PID_HPP_
+
+#include <pid.hpp>
+
+/**
+ * @brief Difference equation used by DiscretePIDController
+ *
+ */
+enum class PIDForm {
+  positional,  // u[k] = P + I + D
+  velocity     // u[k] = u[k-1] + delta P + kI dt e[k] + delta D
+};
+
+/**
+ * @brief How DiscretePIDController keeps the integral bounded while the
+ * output is clamped
+ *
+ */
+enum class AntiWindupMode {
+  none,              // always integrate, like PIDController
+  clamping,          // hold the integral while saturated in the error's sign
+  back_calculation   // bleed the integral by tracking_gain (u_sat - u) dt
+};
+
+/**
+ * @brief PID controller evaluated as a difference equation with cached
+ * discrete coefficients.
+ *
+ * kI dt, the tracking gain times dt and the derivative filter pole and
+ * gain are computed on the first compute() after a setter changed one of
+ * their inputs, so the per-tick path only multiplies and adds. The
+ * derivative is filtered by kD s / (Tf s + 1), discretized with backward
+ * Euler; Tf = 0 gives the unfiltered kD (e[k] - e[k-1]) / dt of
+ * PIDController. The integral is kept in output units, so changing kI does
+ * not bump the output. In velocity form the clamped previous output carries
+ * the integral, which makes it windup-free and the anti-windup mode is not
+ * used.
+ *
+ */
+class DiscretePIDController : public AbstractPIDController {
+ public:
+  /**
+   * @brief Construct a new DiscretePIDController object in positional form,
+   * without derivative filter or anti-windup
+   *
+   * @param kP proportional gain
+   * @param kI integral gain
+   * @param kD differential gain
+   * @param max_value maximum value that the parameter (ex: velocity) can have
+   * @param min_value minimum value that the parameter (ex: velocity) can have
+   * @param dt sampling time
+   */
+  DiscretePIDController(double kP, double kI, double kD, double max_value,
+                        double min_value, double dt);
+
+  /**
+   * @brief Destroy the DiscretePIDController object
+   *
+   */
+  ~DiscretePIDController();
+
+  /**
+   * @brief Compute the next output
+   *
+   * @param setpoint_value desired value
+   * @param measured_value measured value
+   * @return double
+   */
+  double compute(double setpoint_value, double measured_value) override;
+
+  // AbstractPIDController accessors. set_dt() throws std::invalid_argument
+  // for dt <= 0; set_dt(), set_kI() and set_kD() invalidate the cached
+  // coefficients.
+  double get_dt() const override;
+  void set_dt(double dT) override;
+  double get_kD() const override;
+  void set_kD(double kd) override;
+  double get_kI() const override;
+  void set_kI(double ki) override;
+  double get_kP() const override;
+  void set_kP(double kp) override;
+  double get_max_value() const override;
+  void set_max_value(double maxValue) override;
+  double get_min_value() const override;
+  void set_min_value(double minValue) override;
+  double get_prev_error() const override;
+
+  /**
+   * @brief Get the integral of the error over time, i.e. the integral term
+   * divided by kI (0 when kI is 0)
+   *
+   * @return double
+   */
+  double get_integral_sum() const override;
+
+  /**
+   * @brief Get the integral term, in output units
+   *
+   * @return double
+   */
+  double get_integral_term() const;
+
+  /**
+   * @brief Get the derivative filter time constant
+   *
+   * @return double
+   */
+  double get_derivative_filter() const;
+
+  /**
+   * @brief Set the derivative filter time constant Tf, 0 to disable
+   *
+   * @param time_constant Tf in seconds, >= 0
+   */
+  void set_derivative_filter(double time_constant);
+
+  /**
+   * @brief Get the difference equation in use
+   *
+   * @return PIDForm
+   */
+  PIDForm get_form() const;
+
+  /**
+   * @brief Switch the difference equation; the state carries over, so the
+   * switch does not bump the output
+   *
+   * @param pid_form positional or velocity
+   */
+  void set_form(PIDForm pid_form);
+
+  /**
+   * @brief Get the anti-windup mode
+   *
+   * @return AntiWindupMode
+   */
+  AntiWindupMode get_anti_windup() const;
+
+  /**
+   * @brief Set the anti-windup mode of the positional form
+   *
+   * @param mode none, clamping or back_calculation
+   */
+  void set_anti_windup(AntiWindupMode mode);
+
+  /**
+   * @brief Get the back-calculation tracking gain
+   *
+   * @return double
+   */
+  double get_tracking_gain() const;
+
+  /**
+   * @brief Set the back-calculation tracking gain, in 1 / s
+   *
+   * @param gain tracking gain, >= 0
+   */
+  void set_tracking_gain(double gain);
+
+  /**
+   * @brief Clear the integral, derivative, previous error and previous
+   * output
+   *
+   */
+  void reset();
+
+ private:
+  /**
+   * @brief Recompute the cached discrete coefficients
+   *
+   */
+  void update_coefficients();
+
+  double kP;
+  double kI;
+  double kD;
+  double max_value;
+  double min_value;
+  double dt;
+  double filter_time;
+  double tracking_gain;
+  PIDForm form;
+  AntiWindupMode anti_windup;
+
+  bool coefficients_valid;
+  double kI_dt;
+  double tracking_gain_dt;
+  double filter_pole;      // Tf / (Tf + dt)
+  double derivative_gain;  // kD / (Tf + dt)
+
+  double integral_term;
+  double derivative_term;
+  double prev_error;
+  double prev_output;
+};
+
+#endif  // INCLUDE_DISCRETE_PID_HPP_
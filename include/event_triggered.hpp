@@ -0,0 +1,169 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_EVENT_TRIGGERED_HPP_
+#define INCLUDE_EVENT_TRIGGERED_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gain_update.hpp>
+#include <pid.hpp>
+
+/**
+ * @brief Send-on-delta wrapper around a PIDController. update() recomputes
+ * only when the error has moved by more than a threshold since the last
+ * compute, or when max_interval has passed; otherwise the previous output
+ * is held and nothing is computed.
+ *
+ * Held samples are still integrated, each over the time since the sample
+ * before it, and folded into the controller's state on the next compute,
+ * which then runs over the last sample interval through
+ * PIDController::compute_with_dt(). The integral and the derivative thus
+ * follow a controller that computes every sample; only the output is held.
+ *
+ */
+class EventTriggeredController {
+ public:
+  /**
+   * @brief Construct a new EventTriggeredController object. Throws
+   * std::invalid_argument for dt <= 0, a negative threshold or
+   * max_interval <= 0.
+   *
+   * @param gains gains, limits and nominal sampling time
+   * @param threshold smallest error change that triggers a compute, >= 0
+   * @param max_interval longest time without a compute, > 0
+   */
+  EventTriggeredController(const GainSet& gains, double threshold,
+                           double max_interval);
+
+  /**
+   * @brief Recompute if triggered. The first call always computes, over
+   * the nominal dt. A timestamp that does not move forward never computes.
+   *
+   * @param timestamp time of the sample in seconds
+   * @param setpoint_value target value of the parameter
+   * @param measured_value current measured estimate of the parameter
+   * @return bool true if the output was recomputed
+   */
+  bool update(double timestamp, double setpoint_value, double measured_value);
+
+  /**
+   * @brief Get the latest output, held between computes
+   *
+   * @return double
+   */
+  double get_output() const;
+
+  /**
+   * @brief Get the wrapped controller, e.g. to change gains or snapshot it.
+   * Its integral does not include samples held since the last compute.
+   *
+   * @return PIDController&
+   */
+  PIDController& get_controller();
+
+  double get_threshold() const;
+  void set_threshold(double threshold);
+  double get_max_interval() const;
+  void set_max_interval(double max_interval);
+
+  /**
+   * @brief Get the number of update() calls that recomputed
+   *
+   * @return uint64_t
+   */
+  uint64_t get_compute_count() const;
+
+  /**
+   * @brief Get the number of update() calls that held the output
+   *
+   * @return uint64_t
+   */
+  uint64_t get_skip_count() const;
+
+  /**
+   * @brief Clear the controller state and the trigger so the next update()
+   * computes
+   *
+   */
+  void reset();
+
+ private:
+  PIDController controller;
+  double threshold;
+  double max_interval;
+  bool started;
+  double last_timestamp;  // of the last compute
+  double last_error;
+  double sample_timestamp;  // of the last sample, computed or held
+  double sample_error;
+  double held_integral;  // integral of the held samples
+  double output;
+  uint64_t computes;
+  uint64_t skips;
+};
+
+/**
+ * @brief Many EventTriggeredControllers updated together, reporting which
+ * ones produced a new output so downstream stages only process those
+ *
+ */
+class EventTriggeredBatch {
+ public:
+  /**
+   * @brief Append a controller
+   *
+   * @param gains gains, limits and nominal sampling time
+   * @param threshold smallest error change that triggers a compute, >= 0
+   * @param max_interval longest time without a compute, > 0
+   * @return std::size_t index of the new controller
+   */
+  std::size_t add(const GainSet& gains, double threshold,
+                  double max_interval);
+
+  /**
+   * @brief Get the number of controllers
+   *
+   * @return std::size_t
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Update every controller at one timestamp
+   *
+   * @param timestamp time of the samples in seconds
+   * @param setpoints size() target values
+   * @param measured size() measured values
+   * @param outputs size() outputs; only entries of changed controllers are
+   *        written
+   * @param changed receives the indices of the controllers that
+   *        recomputed, in increasing order; room for size() entries
+   * @return std::size_t number of indices written to changed
+   */
+  std::size_t update(double timestamp, const double* setpoints,
+                     const double* measured, double* outputs,
+                     std::size_t* changed);
+
+  /**
+   * @brief Get one controller
+   *
+   * @param index controller index
+   * @return EventTriggeredController&
+   */
+  EventTriggeredController& get(std::size_t index);
+
+ private:
+  std::vector<EventTriggeredController> controllers;
+};
+
+#endif  // INCLUDE_EVENT_TRIGGERED_HPP_
@@ -0,0 +1,207 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_FIXED_POINT_HPP_
+#define INCLUDE_FIXED_POINT_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Signed 32-bit fixed-point number with FractionBits fractional bits
+ * (Q(31 - FractionBits).FractionBits).
+ *
+ * Every operation saturates at the representable range instead of wrapping,
+ * products and quotients are rounded to nearest, and division by zero
+ * saturates towards the sign of the dividend. Conversions to and from
+ * double are explicit.
+ *
+ */
+template <int FractionBits>
+class FixedPoint {
+  static_assert(FractionBits > 0 && FractionBits < 31,
+                "FractionBits should be in [1, 30].");
+
+ public:
+  /**
+   * @brief Construct zero
+   *
+   */
+  FixedPoint() : raw(0) {
+  }
+
+  /**
+   * @brief Convert from double, rounding to nearest and saturating. NaN
+   * becomes zero.
+   *
+   * @param value value to represent
+   */
+  explicit FixedPoint(double value) : raw(from_double(value)) {
+  }
+
+  /**
+   * @brief Construct from the raw two's complement representation
+   *
+   * @param value raw value, i.e. the number times 2^FractionBits
+   * @return FixedPoint
+   */
+  static FixedPoint from_raw(int32_t value) {
+    FixedPoint result;
+    result.raw = value;
+    return result;
+  }
+
+  /**
+   * @brief Get the raw representation
+   *
+   * @return int32_t
+   */
+  int32_t get_raw() const {
+    return raw;
+  }
+
+  /**
+   * @brief Largest representable value
+   *
+   * @return FixedPoint
+   */
+  static FixedPoint max() {
+    return from_raw(std::numeric_limits<int32_t>::max());
+  }
+
+  /**
+   * @brief Most negative representable value
+   *
+   * @return FixedPoint
+   */
+  static FixedPoint lowest() {
+    return from_raw(std::numeric_limits<int32_t>::min());
+  }
+
+  /**
+   * @brief Convert to double, exactly
+   *
+   * @return double
+   */
+  explicit operator double() const {
+    return static_cast<double>(raw) * (1.0 / kOne);
+  }
+
+  FixedPoint operator-() const {
+    return from_raw(saturate(-static_cast<int64_t>(raw)));
+  }
+
+  friend FixedPoint operator+(FixedPoint a, FixedPoint b) {
+    return from_raw(saturate(static_cast<int64_t>(a.raw) + b.raw));
+  }
+
+  friend FixedPoint operator-(FixedPoint a, FixedPoint b) {
+    return from_raw(saturate(static_cast<int64_t>(a.raw) - b.raw));
+  }
+
+  friend FixedPoint operator*(FixedPoint a, FixedPoint b) {
+    int64_t product = static_cast<int64_t>(a.raw) * b.raw;
+    // Round half up, then an arithmetic shift.
+    return from_raw(saturate((product + kHalf) >> FractionBits));
+  }
+
+  friend FixedPoint operator/(FixedPoint a, FixedPoint b) {
+    if (b.raw == 0) {
+      return a.raw > 0 ? max() : (a.raw < 0 ? lowest() : FixedPoint());
+    }
+    int64_t numerator = static_cast<int64_t>(a.raw) * kOne;
+    int64_t divisor = b.raw;
+    int64_t half = (divisor < 0 ? -divisor : divisor) / 2;
+    // Round half away from zero.
+    numerator += numerator < 0 ? -half : half;
+    return from_raw(saturate(numerator / divisor));
+  }
+
+  FixedPoint& operator+=(FixedPoint other) {
+    return *this = *this + other;
+  }
+
+  FixedPoint& operator-=(FixedPoint other) {
+    return *this = *this - other;
+  }
+
+  FixedPoint& operator*=(FixedPoint other) {
+    return *this = *this * other;
+  }
+
+  FixedPoint& operator/=(FixedPoint other) {
+    return *this = *this / other;
+  }
+
+  friend bool operator==(FixedPoint a, FixedPoint b) {
+    return a.raw == b.raw;
+  }
+
+  friend bool operator!=(FixedPoint a, FixedPoint b) {
+    return a.raw != b.raw;
+  }
+
+  friend bool operator<(FixedPoint a, FixedPoint b) {
+    return a.raw < b.raw;
+  }
+
+  friend bool operator>(FixedPoint a, FixedPoint b) {
+    return a.raw > b.raw;
+  }
+
+  friend bool operator<=(FixedPoint a, FixedPoint b) {
+    return a.raw <= b.raw;
+  }
+
+  friend bool operator>=(FixedPoint a, FixedPoint b) {
+    return a.raw >= b.raw;
+  }
+
+ private:
+  static constexpr int64_t kOne = int64_t(1) << FractionBits;
+  static constexpr int64_t kHalf = int64_t(1) << (FractionBits - 1);
+
+  static int32_t saturate(int64_t value) {
+    if (value > std::numeric_limits<int32_t>::max()) {
+      return std::numeric_limits<int32_t>::max();
+    }
+    if (value < std::numeric_limits<int32_t>::min()) {
+      return std::numeric_limits<int32_t>::min();
+    }
+    return static_cast<int32_t>(value);
+  }
+
+  static int32_t from_double(double value) {
+    if (std::isnan(value)) {
+      return 0;
+    }
+    double scaled = value * static_cast<double>(kOne);
+    if (scaled >= static_cast<double>(std::numeric_limits<int32_t>::max())) {
+      return std::numeric_limits<int32_t>::max();
+    }
+    if (scaled <= static_cast<double>(std::numeric_limits<int32_t>::min())) {
+      return std::numeric_limits<int32_t>::min();
+    }
+    return static_cast<int32_t>(std::llround(scaled));
+  }
+
+  int32_t raw;
+};
+
+/**
+ * @brief Q16.16: 16 integer bits including the sign, 16 fractional bits,
+ * range [-32768, 32768), resolution 2^-16
+ *
+ */
+typedef FixedPoint<16> Q16_16;
+
+#endif  // INCLUDE_FIXED_POINT_HPP_
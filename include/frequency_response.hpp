@@ -0,0 +1,168 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_FREQUENCY_RESPONSE_HPP_
+#define INCLUDE_FREQUENCY_RESPONSE_HPP_
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include <gain_update.hpp>
+#include <pid.hpp>
+#include <plant.hpp>
+
+/**
+ * @brief Frequency grid of a FrequencyAnalyzer. Points are spaced
+ * logarithmically in normalized frequency w dt, from the Nyquist frequency
+ * pi / dt down by the given number of decades, so every configuration
+ * shares the same grid whatever its dt.
+ *
+ */
+struct FrequencyOptions {
+  std::size_t points = 2048;  // >= 2
+  double decades = 4.0;       // > 0
+};
+
+/**
+ * @brief Stability margins and closed-loop bandwidth of one configuration.
+ * Frequencies are in rad/s. A quantity whose crossing is not on the grid is
+ * infinite.
+ *
+ */
+struct StabilityMargins {
+  double gain_margin;      // dB, smallest over the phase crossovers
+  double phase_crossover;  // where the open-loop phase crosses -180 deg
+  double phase_margin;     // degrees, smallest over the gain crossovers
+  double gain_crossover;   // where the open-loop gain crosses 0 dB
+  double bandwidth;        // where the closed-loop gain falls 3 dB below
+                           // its value at the lowest grid frequency
+};
+
+/**
+ * @brief Open- and closed-loop response of one configuration on the grid
+ *
+ */
+struct FrequencyResponse {
+  std::vector<double> frequency;     // rad/s
+  std::vector<double> open_gain;     // dB
+  std::vector<double> open_phase;    // degrees, unwrapped
+  std::vector<double> closed_gain;   // dB
+  std::vector<double> closed_phase;  // degrees, unwrapped
+};
+
+/**
+ * @brief Frequency-response analysis of many controller and plant
+ * configurations.
+ *
+ * The controller is PIDController's difference equation as a transfer
+ * function, C(z) = kP + kI dt / (1 - z^-1) + kD / dt (1 - z^-1), without
+ * the output clamp. The plant is its DiscretePlantModel, so the open loop
+ * L = C P matches the loop of simulate_step_response(), and the closed
+ * loop is L / (1 + L) from setpoint to plant output.
+ *
+ * Configurations are stored as parallel arrays. analyze() spreads them over
+ * threads; each configuration is evaluated over the whole grid at once with
+ * the complex arithmetic written out on separate real and imaginary arrays.
+ * The build compiles that loop at -O3 whatever the build type, so it is
+ * always vectorized. The sines and cosines of the grid are computed once
+ * and shared, and so is the dead-time factor z^-d of every distinct delay.
+ *
+ */
+class FrequencyAnalyzer {
+ public:
+  /**
+   * @brief Construct a new FrequencyAnalyzer object. Throws
+   * std::invalid_argument for fewer than 2 points or decades <= 0.
+   *
+   * @param options frequency grid
+   */
+  explicit FrequencyAnalyzer(
+      const FrequencyOptions& options = FrequencyOptions());
+
+  /**
+   * @brief Add a configuration from a controller's current kP, kI, kD and
+   * dt. Throws std::invalid_argument when the plant cannot be discretized
+   * at that dt.
+   *
+   * @param controller configured controller, read through its getters
+   * @param plant plant description
+   * @return std::size_t index of the configuration
+   */
+  std::size_t add(const AbstractPIDController& controller,
+                  const PlantParams& plant);
+
+  /**
+   * @brief Add a configuration from a gain set. Throws
+   * std::invalid_argument when the plant cannot be discretized at gains.dt.
+   *
+   * @param gains controller gains and sampling time; limits are ignored
+   * @param plant plant description
+   * @return std::size_t index of the configuration
+   */
+  std::size_t add(const GainSet& gains, const PlantParams& plant);
+
+  /**
+   * @brief Get the number of configurations
+   *
+   * @return std::size_t
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Compute the margins and bandwidth of every configuration
+   *
+   * @param threads number of threads, 0 for one per core
+   * @return std::vector<StabilityMargins> margins per configuration
+   */
+  std::vector<StabilityMargins> analyze(unsigned threads = 0) const;
+
+  /**
+   * @brief Get the full open- and closed-loop response of one
+   * configuration, e.g. for a Bode plot. Throws std::out_of_range for a bad
+   * index.
+   *
+   * @param index configuration index
+   * @return FrequencyResponse
+   */
+  FrequencyResponse get_response(std::size_t index) const;
+
+ private:
+  /**
+   * @brief Open-loop response L of one configuration on the grid
+   *
+   * @param index configuration index
+   * @param real receives Re L, one entry per grid point
+   * @param imag receives Im L, one entry per grid point
+   */
+  void open_loop(std::size_t index, double* real, double* imag) const;
+
+  std::vector<double> theta;  // w dt of every grid point
+  std::vector<double> cosine;
+  std::vector<double> sine;
+  std::vector<double> versine;  // 1 - cosine
+  std::vector<double> kP;
+  std::vector<double> kI;
+  std::vector<double> kD;
+  std::vector<double> dt;
+  std::vector<double> a11;
+  std::vector<double> a12;
+  std::vector<double> a21;
+  std::vector<double> a22;
+  std::vector<double> b1;
+  std::vector<double> b2;
+  std::vector<std::size_t> delay_samples;
+  std::map<std::size_t, std::size_t> delay_rows;  // delay -> row below
+  std::vector<double> delay_real;  // Re z^-delay, one grid-sized row each
+  std::vector<double> delay_imag;  // Im z^-delay
+};
+
+#endif  // INCLUDE_FREQUENCY_RESPONSE_HPP_
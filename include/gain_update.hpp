@@ -0,0 +1,86 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_GAIN_UPDATE_HPP_
+#define INCLUDE_GAIN_UPDATE_HPP_
+
+#include <cstdint>
+
+#include <seqlock.hpp>
+
+/**
+ * @brief Complete set of tunable PIDController parameters
+ *
+ */
+struct GainSet {
+  double kP;
+  double kI;
+  double kD;
+  double max_value;
+  double min_value;
+  double dt;
+};
+
+/**
+ * @brief A GainSet as published on a GainUpdateChannel
+ *
+ */
+struct GainUpdate {
+  GainSet gains;
+  // Adjust integral_sum when applying so the output does not jump.
+  bool bumpless;
+};
+
+/**
+ * @brief Carries gain sets from one tuning thread to the control thread(s).
+ * publish() and poll() are both wait-free and allocation-free: the tuning
+ * thread never stalls the loop, and a loop that races with a publish just
+ * picks the new gains up on its next tick.
+ *
+ */
+class GainUpdateChannel {
+ public:
+  /**
+   * @brief Construct a new GainUpdateChannel object with nothing published
+   *
+   */
+  GainUpdateChannel();
+
+  /**
+   * @brief Publish a complete gain set. Only one thread may publish.
+   *
+   * @param gains new gains, limits and sampling time
+   * @param bumpless adjust integral_sum on apply to keep the output continuous
+   */
+  void publish(const GainSet& gains, bool bumpless = false);
+
+  /**
+   * @brief Fetch the latest update if it is newer than *last_version
+   *
+   * @param last_version version already applied by the caller; updated on
+   *        success
+   * @param update receives the new update
+   * @return true if a newer, consistent update was read
+   */
+  bool poll(uint64_t* last_version, GainUpdate* update) const;
+
+  /**
+   * @brief Get the version of the latest publish (0 = nothing published)
+   *
+   * @return uint64_t
+   */
+  uint64_t get_version() const;
+
+ private:
+  Seqlock<GainUpdate> latest;
+};
+
+#endif  // INCLUDE_GAIN_UPDATE_HPP_
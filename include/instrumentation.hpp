@@ -0,0 +1,269 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_INSTRUMENTATION_HPP_
+#define INCLUDE_INSTRUMENTATION_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Log-bucketed latency histogram with 8 sub-buckets per power of
+ * two: values below 8 ns have their own bucket, larger ones are recorded
+ * with a relative error below 12.5%. Values of 2^32 ns and more land in
+ * the last bucket.
+ *
+ */
+struct LatencyBuckets {
+  static constexpr int kSubBucketBits = 3;
+  static constexpr std::size_t kSubBuckets = std::size_t(1) << kSubBucketBits;
+  static constexpr int kMaxMagnitude = 32;
+  static constexpr std::size_t kCount =
+      kSubBuckets * (kMaxMagnitude - kSubBucketBits + 1);
+
+  /**
+   * @brief Get the bucket a latency falls into
+   *
+   * @param nanoseconds latency
+   * @return std::size_t
+   */
+  static std::size_t index(uint64_t nanoseconds) {
+    if (nanoseconds < kSubBuckets) {
+      return static_cast<std::size_t>(nanoseconds);
+    }
+    int magnitude = 63 - __builtin_clzll(nanoseconds);
+    if (magnitude >= kMaxMagnitude) {
+      return kCount - 1;
+    }
+    std::size_t sub = static_cast<std::size_t>(
+        nanoseconds >> (magnitude - kSubBucketBits)) & (kSubBuckets - 1);
+    return kSubBuckets * (magnitude - kSubBucketBits + 1) + sub;
+  }
+
+  /**
+   * @brief Get the smallest latency recorded in a bucket
+   *
+   * @param bucket bucket index, < kCount
+   * @return uint64_t
+   */
+  static uint64_t lower_bound(std::size_t bucket) {
+    if (bucket < kSubBuckets) {
+      return bucket;
+    }
+    int magnitude = static_cast<int>(bucket / kSubBuckets) + kSubBucketBits - 1;
+    uint64_t sub = bucket % kSubBuckets;
+    return (kSubBuckets + sub) << (magnitude - kSubBucketBits);
+  }
+
+  /**
+   * @brief Get the largest latency recorded in a bucket (the last bucket
+   * is open-ended and reports its lower bound times two)
+   *
+   * @param bucket bucket index, < kCount
+   * @return uint64_t
+   */
+  static uint64_t upper_bound(std::size_t bucket) {
+    if (bucket + 1 == kCount) {
+      return uint64_t(1) << kMaxMagnitude;
+    }
+    return lower_bound(bucket + 1) - 1;
+  }
+};
+
+/**
+ * @brief Point-in-time copy of a ComputeInstrumentation
+ *
+ */
+struct InstrumentationSnapshot {
+  uint64_t calls;            // compute() calls
+  uint64_t saturated_max;    // outputs clamped to max_value
+  uint64_t saturated_min;    // outputs clamped to min_value
+  uint64_t integral_growth;  // calls that increased |integral_sum|
+  double peak_integral;      // largest |integral_sum| seen
+  uint64_t max_latency_ns;   // slowest compute()
+  std::array<uint64_t, LatencyBuckets::kCount> latency;
+
+  /**
+   * @brief Get the number of latencies in the histogram
+   *
+   * @return uint64_t
+   */
+  uint64_t get_latency_count() const {
+    uint64_t total = 0;
+    for (uint64_t count : latency) {
+      total += count;
+    }
+    return total;
+  }
+
+  /**
+   * @brief Get a latency percentile, reported as the upper bound of the
+   * bucket it falls into (never above the largest latency seen)
+   *
+   * @param quantile in [0, 1], e.g. 0.99
+   * @return uint64_t nanoseconds, 0 if nothing was recorded
+   */
+  uint64_t get_latency_percentile(double quantile) const {
+    uint64_t total = get_latency_count();
+    if (total == 0) {
+      return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(quantile * total);
+    if (rank >= total) {
+      rank = total - 1;
+    }
+    uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < latency.size(); ++bucket) {
+      seen += latency[bucket];
+      if (seen > rank) {
+        uint64_t bound = LatencyBuckets::upper_bound(bucket);
+        return bound < max_latency_ns ? bound : max_latency_ns;
+      }
+    }
+    return max_latency_ns;
+  }
+};
+
+/**
+ * @brief Per-controller counters and compute() latency histogram.
+ *
+ * Written by the control thread only, with relaxed load/store pairs so the
+ * hot path has no locked instructions; any other thread may call
+ * snapshot() at any time without locking. Each field of a snapshot is a
+ * value the field actually had, but fields are read one by one, so a
+ * snapshot taken mid-update may be one call apart between fields.
+ *
+ * Controllers embed one when the library is built with the
+ * PID_INSTRUMENTATION CMake option; otherwise they do not contain or
+ * update it at all.
+ *
+ */
+class ComputeInstrumentation {
+ public:
+  ComputeInstrumentation() {
+    clear();
+  }
+
+  /**
+   * @brief Copy the current values, e.g. when the owning controller is
+   * copied
+   *
+   * @param other instrumentation to copy
+   */
+  ComputeInstrumentation(const ComputeInstrumentation& other) {
+    restore(other.snapshot());
+  }
+
+  ComputeInstrumentation& operator=(const ComputeInstrumentation& other) {
+    restore(other.snapshot());
+    return *this;
+  }
+
+  /**
+   * @brief Record one compute() call. Only the control thread may call it.
+   *
+   * @param latency_ns duration of the call
+   * @param saturated +1 clamped to max, -1 clamped to min, 0 otherwise
+   * @param integral_before |integral_sum| before the call
+   * @param integral_after |integral_sum| after the call
+   */
+  void record(uint64_t latency_ns, int saturated, double integral_before,
+              double integral_after) {
+    bump(&calls);
+    if (saturated > 0) {
+      bump(&saturated_max);
+    } else if (saturated < 0) {
+      bump(&saturated_min);
+    }
+    if (integral_after > integral_before) {
+      bump(&integral_growth);
+      if (integral_after > load_double(peak_integral)) {
+        store_double(&peak_integral, integral_after);
+      }
+    }
+    if (latency_ns > max_latency_ns.load(std::memory_order_relaxed)) {
+      max_latency_ns.store(latency_ns, std::memory_order_relaxed);
+    }
+    bump(&latency[LatencyBuckets::index(latency_ns)]);
+  }
+
+  /**
+   * @brief Copy the counters and the histogram. Safe from any thread.
+   *
+   * @return InstrumentationSnapshot
+   */
+  InstrumentationSnapshot snapshot() const {
+    InstrumentationSnapshot result;
+    result.calls = calls.load(std::memory_order_relaxed);
+    result.saturated_max = saturated_max.load(std::memory_order_relaxed);
+    result.saturated_min = saturated_min.load(std::memory_order_relaxed);
+    result.integral_growth = integral_growth.load(std::memory_order_relaxed);
+    result.peak_integral = load_double(peak_integral);
+    result.max_latency_ns = max_latency_ns.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < LatencyBuckets::kCount; ++i) {
+      result.latency[i] = latency[i].load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Zero everything. Only the control thread may call it.
+   *
+   */
+  void clear() {
+    InstrumentationSnapshot zero = {};
+    restore(zero);
+  }
+
+ private:
+  static void bump(std::atomic<uint64_t>* counter) {
+    counter->store(counter->load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+  }
+
+  static double load_double(const std::atomic<uint64_t>& bits) {
+    uint64_t raw = bits.load(std::memory_order_relaxed);
+    double value;
+    std::memcpy(&value, &raw, sizeof(value));
+    return value;
+  }
+
+  static void store_double(std::atomic<uint64_t>* bits, double value) {
+    uint64_t raw;
+    std::memcpy(&raw, &value, sizeof(raw));
+    bits->store(raw, std::memory_order_relaxed);
+  }
+
+  void restore(const InstrumentationSnapshot& values) {
+    calls.store(values.calls, std::memory_order_relaxed);
+    saturated_max.store(values.saturated_max, std::memory_order_relaxed);
+    saturated_min.store(values.saturated_min, std::memory_order_relaxed);
+    integral_growth.store(values.integral_growth, std::memory_order_relaxed);
+    store_double(&peak_integral, values.peak_integral);
+    max_latency_ns.store(values.max_latency_ns, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < LatencyBuckets::kCount; ++i) {
+      latency[i].store(values.latency[i], std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> saturated_max;
+  std::atomic<uint64_t> saturated_min;
+  std::atomic<uint64_t> integral_growth;
+  std::atomic<uint64_t> peak_integral;  // bits of a double
+  std::atomic<uint64_t> max_latency_ns;
+  std::atomic<uint64_t> latency[LatencyBuckets::kCount];
+};
+
+#endif  // INCLUDE_INSTRUMENTATION_HPP_
@@ -0,0 +1,60 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_MAPPED_FILE_HPP_
+#define INCLUDE_MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file. The contents are paged
+ * in by the kernel on demand and never copied into the process.
+ *
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Map a file. Throws std::runtime_error if it cannot be opened.
+   *
+   * @param path file to map
+   */
+  explicit MappedFile(const std::string& path);
+
+  /**
+   * @brief Destroy the MappedFile object and unmap the file
+   *
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Get the start of the mapped contents
+   *
+   * @return const char* nullptr for an empty file
+   */
+  const char* data() const;
+
+  /**
+   * @brief Get the file size in bytes
+   *
+   * @return std::size_t
+   */
+  std::size_t size() const;
+
+ private:
+  void* address;
+  std::size_t length;
+};
+
+#endif  // INCLUDE_MAPPED_FILE_HPP_
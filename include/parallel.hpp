@@ -0,0 +1,87 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_PARALLEL_HPP_
+#define INCLUDE_PARALLEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Get the number of worker threads to use when the caller passes 0
+ *
+ * @return unsigned hardware concurrency, at least 1
+ */
+inline unsigned default_thread_count() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Call body(i) for every i in [0, count) on up to threads threads.
+ * Indices are handed out dynamically so uneven work stays balanced. The
+ * first exception thrown by body is rethrown once all threads finished.
+ *
+ * @param count number of work items
+ * @param threads number of threads, 0 for default_thread_count()
+ * @param body callable taking a std::size_t index
+ */
+template <typename Body>
+void parallel_for(std::size_t count, unsigned threads, Body body) {
+  if (threads == 0) {
+    threads = default_thread_count();
+  }
+  if (count < threads) {
+    threads = static_cast<unsigned>(count);
+  }
+  if (threads <= 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      body(i);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next(0);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&]() {
+    std::size_t i;
+    while ((i = next.fetch_add(1)) < count) {
+      try {
+        body(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        next.store(count);
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+#endif  // INCLUDE_PARALLEL_HPP_
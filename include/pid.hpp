@@ -12,6 +12,14 @@
 #ifndef INCLUDE_PID_HPP_
 #define INCLUDE_PID_HPP_
 
+#include <cstdint>
+
+#include <fixed_point.hpp>
+#include <gain_update.hpp>
+#include <instrumentation.hpp>
+#include <pid_status.hpp>
+#include <telemetry.hpp>
+
 /**
  * @brief PIDController interface will have the compute() method.
  * This can be implemented by any concrete class
@@ -66,12 +74,21 @@ class AbstractPIDController : public PIDControllerInterface {
 
 /**
  * @brief Concrete implementation of the PIDController abstract class and interface.
+ * The gains, limits and state are stored and computed in Scalar; the
+ * AbstractPIDController interface stays in double and converts at the
+ * boundary. Instantiated in pid.cpp for float, double and Q16_16, whose
+ * saturating arithmetic keeps the sums and the clamp overflow-safe.
  * 
  */
-class PIDController : public AbstractPIDController {
+template <typename Scalar>
+class BasicPIDController : public AbstractPIDController {
  public:
+  typedef Scalar scalar_type;
+
   /**
-   * @brief Construct a new PIDController object
+   * @brief Construct a new PIDController object. Throws
+   * std::invalid_argument if dt is not greater than 0 once converted to
+   * Scalar.
    * 
    * @param kP proportional gain
    * @param kI integral gain
@@ -80,13 +97,13 @@ class PIDController : public AbstractPIDController {
    * @param min_value minimum value that the parameter (ex: velocity) can have
    * @param dt sampling time
    */
-  PIDController(double kP, double kI, double kD, double max_value,
+  BasicPIDController(double kP, double kI, double kD, double max_value,
                     double min_value, double dt);
   /**
    * @brief Destroy the PIDController object
    * 
    */
-  ~PIDController();
+  ~BasicPIDController();
 
   /**
    * @brief 
@@ -95,7 +112,46 @@ class PIDController : public AbstractPIDController {
    * @param measured_value current measured estimate of the parameter
    * @return double 
    */
-  double compute(double setpoint_value, double measured_value) override;
+  double compute(double setpoint_value, double measured_value) noexcept
+      override;
+
+  /**
+   * @brief Same as compute(), without converting to and from double
+   *
+   * @param setpoint_value target value of the parameter
+   * @param measured_value current measured estimate of the parameter
+   * @return Scalar
+   */
+  Scalar compute_native(Scalar setpoint_value,
+                        Scalar measured_value) noexcept;
+
+  /**
+   * @brief Same as compute(), over a step of elapsed seconds instead of
+   * get_dt(), for samples that arrive at irregular times. The stored dt is
+   * left unchanged. Throws std::invalid_argument if elapsed is not greater
+   * than 0.
+   *
+   * @param setpoint_value target value of the parameter
+   * @param measured_value current measured estimate of the parameter
+   * @param elapsed time since the previous sample
+   * @return double
+   */
+  double compute_with_dt(double setpoint_value, double measured_value,
+                         double elapsed);
+
+  /**
+   * @brief Same as compute_with_dt(), reporting a bad step as
+   * PIDStatus::invalid_dt instead of throwing. The state is left unchanged
+   * on error.
+   *
+   * @param setpoint_value target value of the parameter
+   * @param measured_value current measured estimate of the parameter
+   * @param elapsed time since the previous sample
+   * @return PIDResult<double> the output
+   */
+  PIDResult<double> try_compute_with_dt(double setpoint_value,
+                                        double measured_value,
+                                        double elapsed) noexcept;
 
   /**
    * @brief Get sampling time - dt
@@ -111,6 +167,15 @@ class PIDController : public AbstractPIDController {
    */
   void set_dt(double dt) override;
 
+  /**
+   * @brief Same as set_dt(), returning PIDStatus::invalid_dt instead of
+   * throwing. dt is left unchanged on error.
+   *
+   * @param dt
+   * @return PIDStatus
+   */
+  PIDStatus try_set_dt(double dt) noexcept;
+
   /**
    * @brief Get value of differential gain kD
    * 
@@ -195,15 +260,150 @@ class PIDController : public AbstractPIDController {
    */
   double get_integral_sum() const;
 
+  /**
+   * @brief Clear the integral sum and the previous error so the next
+   * compute() starts like a freshly constructed controller
+   *
+   */
+  void reset();
+
+  /**
+   * @brief Overwrite the integral sum and the previous error, e.g. to
+   * resume from a snapshot
+   *
+   * @param integral_sum integral of the error over time
+   * @param prev_error error of the last compute()
+   */
+  void set_state(double integral_sum, double prev_error);
+
+  /**
+   * @brief Attach a telemetry sink. Every compute() then pushes one
+   * TelemetryRecord into it without blocking; records are dropped if the
+   * buffer is full. Pass nullptr to detach.
+   *
+   * @param sink ring buffer drained by another thread, or nullptr
+   */
+  void set_telemetry_sink(TelemetryRingBuffer* sink);
+
+  /**
+   * @brief Get the attached telemetry sink
+   *
+   * @return TelemetryRingBuffer* nullptr if none is attached
+   */
+  TelemetryRingBuffer* get_telemetry_sink() const;
+
+  /**
+   * @brief Get all gains, limits and the sampling time at once
+   *
+   * @return GainSet
+   */
+  GainSet get_gains() const;
+
+  /**
+   * @brief Set all gains, limits and the sampling time at once
+   *
+   * @param gains new parameter set, gains.dt must be greater than 0
+   */
+  void set_gains(const GainSet& gains);
+
+  /**
+   * @brief Same as set_gains(), returning PIDStatus::invalid_dt instead of
+   * throwing. Nothing is changed on error.
+   *
+   * @param gains new parameter set
+   * @return PIDStatus
+   */
+  PIDStatus try_set_gains(const GainSet& gains) noexcept;
+
+  /**
+   * @brief Check that a gain set is accepted by the constructor and
+   * set_gains(), i.e. that gains.dt is greater than 0 once converted to
+   * Scalar
+   *
+   * @param gains parameter set to check
+   * @return PIDStatus PIDStatus::ok or PIDStatus::invalid_dt
+   */
+  static PIDStatus check_gains(const GainSet& gains) noexcept;
+
+  /**
+   * @brief Attach a channel a tuning thread publishes gain sets on.
+   * compute() checks it at the start of every tick and applies a newer gain
+   * set before using it, without blocking. Pass nullptr to detach.
+   *
+   * @param channel channel shared with the tuning thread, or nullptr
+   */
+  void set_gain_channel(GainUpdateChannel* channel);
+
+  /**
+   * @brief Get the attached gain channel
+   *
+   * @return GainUpdateChannel* nullptr if none is attached
+   */
+  GainUpdateChannel* get_gain_channel() const;
+
+#ifdef PID_INSTRUMENTATION
+  /**
+   * @brief Get the compute() counters and latency histogram. Only
+   * available when built with the PID_INSTRUMENTATION CMake option; call
+   * snapshot() on it from any thread.
+   *
+   * @return const ComputeInstrumentation&
+   */
+  const ComputeInstrumentation& get_instrumentation() const;
+
+  /**
+   * @brief Zero the counters and the histogram. Only from the thread that
+   * calls compute().
+   *
+   */
+  void clear_instrumentation();
+#endif
+
  private:
-  double kP;
-  double kI;
-  double kD;
-  double max_value;
-  double min_value;
-  double dt;
-  double integral_sum;
-  double prev_error;
+  /**
+   * @brief One tick of the controller
+   *
+   * @param setpoint_value target value of the parameter
+   * @param measured_value current measured estimate of the parameter
+   * @param step time step to use instead of dt, or nullptr for dt
+   * @return Scalar
+   */
+  Scalar update(Scalar setpoint_value, Scalar measured_value,
+                const Scalar* step) noexcept;
+
+  /**
+   * @brief Apply a gain set received from the gain channel. A set whose dt
+   * rounds to 0 in Scalar is ignored, so compute() never throws.
+   *
+   * @param update gain set and bumpless flag
+   */
+  void apply_gain_update(const GainUpdate& update) noexcept;
+
+  Scalar kP;
+  Scalar kI;
+  Scalar kD;
+  Scalar max_value;
+  Scalar min_value;
+  Scalar dt;
+  Scalar kD_over_dt;  // kept in step with kD and dt by their setters
+  Scalar integral_sum;
+  Scalar prev_error;
+  TelemetryRingBuffer* telemetry_sink;
+  GainUpdateChannel* gain_channel;
+  uint64_t gain_version;
+#ifdef PID_INSTRUMENTATION
+  ComputeInstrumentation instrumentation;
+#endif
 };
 
+extern template class BasicPIDController<float>;
+extern template class BasicPIDController<double>;
+extern template class BasicPIDController<Q16_16>;
+
+/**
+ * @brief The double-precision controller
+ *
+ */
+typedef BasicPIDController<double> PIDController;
+
 #endif  // INCLUDE_PID_HPP_
@@ -0,0 +1,156 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_PID_BANK_HPP_
+#define INCLUDE_PID_BANK_HPP_
+
+#include <cstddef>
+
+/**
+ * @brief Batch of independent PID controllers stored as a structure of
+ * arrays. All gains, limits and state live in contiguous 64-byte aligned
+ * arrays so that one compute() call streams through every controller with
+ * SIMD instructions instead of chasing one heap object per controller.
+ *
+ * Every controller produces bit-identical results to a PIDController
+ * constructed with the same parameters and fed the same inputs.
+ */
+class PIDControllerBank {
+ public:
+  /**
+   * @brief Instruction set used by compute()
+   *
+   */
+  enum class Kernel {
+    scalar,
+    sse2,
+    avx
+  };
+
+  /**
+   * @brief Construct an empty PIDControllerBank object
+   *
+   * @param capacity number of controllers to reserve room for
+   */
+  explicit PIDControllerBank(std::size_t capacity = 0);
+
+  /**
+   * @brief Destroy the PIDControllerBank object
+   *
+   */
+  ~PIDControllerBank();
+
+  PIDControllerBank(const PIDControllerBank&) = delete;
+  PIDControllerBank& operator=(const PIDControllerBank&) = delete;
+
+  /**
+   * @brief Append a controller to the bank
+   *
+   * @param kP proportional gain
+   * @param kI integral gain
+   * @param kD differential gain
+   * @param max_value maximum value that the parameter (ex: velocity) can have
+   * @param min_value minimum value that the parameter (ex: velocity) can have
+   * @param dt sampling time
+   * @return std::size_t index of the new controller
+   */
+  std::size_t add(double kP, double kI, double kD, double max_value,
+                  double min_value, double dt);
+
+  /**
+   * @brief Get the number of controllers in the bank
+   *
+   * @return std::size_t
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Run one tick of the first n controllers.
+   * out[i] receives what PIDController::compute(setpoints[i], measured[i])
+   * would return for controller i.
+   *
+   * @param setpoints n target values
+   * @param measured n measured values
+   * @param out n controller outputs
+   * @param n number of controllers to update, at most size()
+   */
+  void compute(const double* setpoints, const double* measured, double* out,
+               std::size_t n);
+
+  /**
+   * @brief Select the instruction set used by compute(). Falls back to the
+   * best available one if the CPU does not support the requested kernel.
+   *
+   * @param kernel requested kernel
+   */
+  void set_kernel(Kernel kernel);
+
+  /**
+   * @brief Get the instruction set used by compute()
+   *
+   * @return Kernel
+   */
+  Kernel get_kernel() const;
+
+  /**
+   * @brief Get the best kernel supported by this CPU
+   *
+   * @return Kernel
+   */
+  static Kernel best_kernel();
+
+  double get_dt(std::size_t index) const;
+  void set_dt(std::size_t index, double dt);
+  double get_kD(std::size_t index) const;
+  void set_kD(std::size_t index, double kD);
+  double get_kI(std::size_t index) const;
+  void set_kI(std::size_t index, double kI);
+  double get_kP(std::size_t index) const;
+  void set_kP(std::size_t index, double kP);
+  double get_max_value(std::size_t index) const;
+  void set_max_value(std::size_t index, double maxValue);
+  double get_min_value(std::size_t index) const;
+  void set_min_value(std::size_t index, double minValue);
+  double get_prev_error(std::size_t index) const;
+  double get_integral_sum(std::size_t index) const;
+
+  /**
+   * @brief Overwrite the integral sum and the previous error of one
+   * controller, e.g. to resume from a snapshot
+   *
+   * @param index controller index
+   * @param integral_sum integral of the error over time
+   * @param prev_error error of the last compute()
+   */
+  void set_state(std::size_t index, double integral_sum, double prev_error);
+
+ private:
+  void grow(std::size_t new_capacity);
+  void check_index(std::size_t index) const;
+
+  std::size_t count;
+  std::size_t capacity;
+  Kernel kernel;
+
+  // One allocation holding all nine arrays back to back.
+  void* storage;
+  double* kP;
+  double* kI;
+  double* kD;
+  double* max_value;
+  double* min_value;
+  double* dt;
+  double* kD_over_dt;  // kept in step with kD and dt by their setters
+  double* integral_sum;
+  double* prev_error;
+};
+
+#endif  // INCLUDE_PID_BANK_HPP_
@@ -0,0 +1,70 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_PID_STATUS_HPP_
+#define INCLUDE_PID_STATUS_HPP_
+
+/**
+ * @brief Error codes of the noexcept API, for threads that must not throw
+ *
+ */
+enum class PIDStatus {
+  ok,
+  invalid_dt,        // dt or elapsed is not greater than 0
+  invalid_argument,  // zero capacity, or a controller the pool did not create
+  in_use,            // the pool still has live controllers
+  pool_exhausted,    // every slot of the pool is taken
+  out_of_memory,     // the arena could not be allocated
+  lock_failed        // the arena could not be locked into memory
+};
+
+/**
+ * @brief Get a short description of a status
+ *
+ * @param status
+ * @return const char* static string, never nullptr
+ */
+inline const char* pid_status_string(PIDStatus status) noexcept {
+  switch (status) {
+    case PIDStatus::ok:
+      return "ok";
+    case PIDStatus::invalid_dt:
+      return "dt should be greater than 0.";
+    case PIDStatus::invalid_argument:
+      return "invalid argument.";
+    case PIDStatus::in_use:
+      return "pool still has live controllers.";
+    case PIDStatus::pool_exhausted:
+      return "pool exhausted.";
+    case PIDStatus::out_of_memory:
+      return "out of memory.";
+    case PIDStatus::lock_failed:
+      return "cannot lock memory.";
+  }
+  return "unknown status.";
+}
+
+/**
+ * @brief A value or the reason there is none. value is only meaningful
+ * when status is PIDStatus::ok.
+ *
+ */
+template <typename T>
+struct PIDResult {
+  PIDStatus status;
+  T value;
+
+  bool ok() const noexcept {
+    return status == PIDStatus::ok;
+  }
+};
+
+#endif  // INCLUDE_PID_STATUS_HPP_
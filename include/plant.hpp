@@ -0,0 +1,147 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_PLANT_HPP_
+#define INCLUDE_PLANT_HPP_
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Kind of continuous-time plant
+ *
+ */
+enum class PlantType {
+  first_order,   // gain / (time_constant s + 1)
+  second_order,  // gain wn^2 / (s^2 + 2 damping wn s + wn^2)
+  dead_time      // gain, pure transport delay only
+};
+
+/**
+ * @brief Continuous-time plant description. dead_time adds a transport
+ * delay to any plant type.
+ *
+ */
+struct PlantParams {
+  PlantType type;
+  double gain;
+  double time_constant;      // first_order only, > 0
+  double natural_frequency;  // second_order only, rad/s, > 0
+  double damping;            // second_order only
+  double dead_time;          // seconds, >= 0
+};
+
+/**
+ * @brief Build a first-order plant description
+ *
+ * @param gain static gain
+ * @param time_constant time constant in seconds
+ * @param dead_time transport delay in seconds
+ * @return PlantParams
+ */
+PlantParams first_order_plant(double gain, double time_constant,
+                              double dead_time = 0);
+
+/**
+ * @brief Build a second-order plant description
+ *
+ * @param gain static gain
+ * @param natural_frequency natural frequency in rad/s
+ * @param damping damping ratio
+ * @param dead_time transport delay in seconds
+ * @return PlantParams
+ */
+PlantParams second_order_plant(double gain, double natural_frequency,
+                               double damping, double dead_time = 0);
+
+/**
+ * @brief Build a pure transport-delay plant description
+ *
+ * @param gain static gain
+ * @param dead_time transport delay in seconds
+ * @return PlantParams
+ */
+PlantParams dead_time_plant(double gain, double dead_time);
+
+/**
+ * @brief Plant discretized at a sampling time, as the two-state system
+ *   x[k+1] = A x[k] + B u[k - delay_samples],  y[k] = x1[k]
+ * First-order plants use the exact zero-order-hold solution, second-order
+ * plants semi-implicit Euler, and the pure delay y[k+1] = gain u.
+ *
+ */
+struct DiscretePlantModel {
+  double a11, a12, a21, a22;
+  double b1, b2;
+  std::size_t delay_samples;
+};
+
+/**
+ * @brief Discretize a plant. Throws std::invalid_argument for invalid
+ * parameters.
+ *
+ * @param params continuous-time plant
+ * @param dt sampling time, > 0
+ * @return DiscretePlantModel
+ */
+DiscretePlantModel discretize(const PlantParams& params, double dt);
+
+/**
+ * @brief One simulated plant with its state and delay line
+ *
+ */
+class DiscretePlant {
+ public:
+  /**
+   * @brief Construct a new DiscretePlant object at rest
+   *
+   * @param params continuous-time plant
+   * @param dt sampling time, > 0
+   */
+  DiscretePlant(const PlantParams& params, double dt);
+
+  /**
+   * @brief Get the current plant output y[k]
+   *
+   * @return double
+   */
+  double output() const;
+
+  /**
+   * @brief Get the sampling time the plant was discretized at
+   *
+   * @return double
+   */
+  double get_dt() const;
+
+  /**
+   * @brief Apply the input u[k] and advance to k + 1
+   *
+   * @param input controller output
+   */
+  void step(double input);
+
+  /**
+   * @brief Return to rest: zero state and an empty delay line
+   *
+   */
+  void reset();
+
+ private:
+  DiscretePlantModel model;
+  double dt;
+  double x1;
+  double x2;
+  std::vector<double> delay_line;
+  std::size_t delay_head;
+};
+
+#endif  // INCLUDE_PLANT_HPP_
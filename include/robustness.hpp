@@ -0,0 +1,219 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_ROBUSTNESS_HPP_
+#define INCLUDE_ROBUSTNESS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gain_update.hpp>
+#include <plant.hpp>
+#include <simulation.hpp>
+
+/**
+ * @brief Fixed-range histogram with linear bins, for percentiles of a
+ * stream of values without storing them. Values outside [lower, upper)
+ * are counted in an underflow or overflow bin. Histograms with the same
+ * layout can be merged.
+ *
+ */
+class Histogram {
+ public:
+  /**
+   * @brief Construct an empty histogram. Throws std::invalid_argument
+   * unless lower < upper and bins > 0.
+   *
+   * @param lower lower edge of the first bin
+   * @param upper upper edge of the last bin
+   * @param bins number of bins between them
+   */
+  Histogram(double lower, double upper, std::size_t bins);
+
+  /**
+   * @brief Count one value. NaN is ignored.
+   *
+   * @param value
+   */
+  void add(double value);
+
+  /**
+   * @brief Add the counts of another histogram. Throws
+   * std::invalid_argument if the layouts differ.
+   *
+   * @param other histogram with the same lower, upper and bins
+   */
+  void merge(const Histogram& other);
+
+  /**
+   * @brief Get the number of values counted
+   *
+   * @return uint64_t
+   */
+  uint64_t get_count() const;
+
+  /**
+   * @brief Get the smallest value counted, 0 if none
+   *
+   * @return double
+   */
+  double get_min() const;
+
+  /**
+   * @brief Get the largest value counted, 0 if none
+   *
+   * @return double
+   */
+  double get_max() const;
+
+  /**
+   * @brief Get the mean of the values counted, 0 if none
+   *
+   * @return double
+   */
+  double get_mean() const;
+
+  /**
+   * @brief Get a percentile, reported as the upper edge of the bin it falls
+   * into (never above the largest value seen, never below the smallest)
+   *
+   * @param quantile in [0, 1], e.g. 0.99
+   * @return double 0 if nothing was counted
+   */
+  double get_percentile(double quantile) const;
+
+ private:
+  double lower;
+  double upper;
+  double bin_width;
+  std::vector<uint64_t> bins;  // underflow, the bins, overflow
+  uint64_t count;
+  double sum;
+  double min_value;
+  double max_value;
+};
+
+/**
+ * @brief How one plant parameter is drawn around its nominal value
+ *
+ */
+enum class Distribution {
+  fixed,    // always the nominal value
+  uniform,  // nominal * (1 + spread * u), u uniform in [-1, 1]
+  normal    // nominal * (1 + spread * z), z standard normal cut at +-3
+};
+
+/**
+ * @brief Relative spread of one plant parameter
+ *
+ */
+struct ParameterSpread {
+  Distribution distribution = Distribution::fixed;
+  double spread = 0.0;  // < 1 for uniform, < 1/3 for normal
+};
+
+/**
+ * @brief Nominal plant and the spread of each of its parameters. The
+ * parameters are drawn independently.
+ *
+ */
+struct PlantDistribution {
+  PlantParams nominal;
+  ParameterSpread gain;
+  ParameterSpread time_constant;
+  ParameterSpread natural_frequency;
+  ParameterSpread damping;
+  ParameterSpread dead_time;
+};
+
+/**
+ * @brief Spread every parameter of a plant uniformly by the same fraction,
+ * e.g. 0.3 for +-30 %
+ *
+ * @param nominal nominal plant
+ * @param spread relative spread, in [0, 1)
+ * @return PlantDistribution
+ */
+PlantDistribution uniform_spread(const PlantParams& nominal, double spread);
+
+/**
+ * @brief Settings of a robustness analysis
+ *
+ */
+struct RobustnessOptions {
+  SimulationOptions simulation;    // step-response experiment per sample
+  std::size_t samples = 100000;    // number of sampled plants
+  uint64_t seed = 0;               // same seed, same plants
+  unsigned threads = 0;            // 0 for one per core
+  double max_overshoot = 100.0;    // overshoot histogram range, in percent
+  std::size_t histogram_bins = 1000;
+
+  RobustnessOptions() {
+    // Samples ten times past the setpoint are clearly unstable.
+    simulation.divergence_limit = 10.0;
+  }
+};
+
+/**
+ * @brief Aggregated outcome of a robustness analysis. Every sample either
+ * settled, diverged or neither (still oscillating or creeping when the
+ * horizon ended).
+ *
+ */
+struct RobustnessReport {
+  uint64_t samples;
+  uint64_t settled;
+  uint64_t diverged;
+  Histogram overshoot;      // percent, of every sample that did not diverge
+  Histogram settling_time;  // seconds, of every sample that settled
+  Histogram iae;            // of every sample that did not diverge
+  PlantParams worst_plant;  // a diverged plant if any, else the largest IAE
+  double worst_iae;         // IAE of worst_plant, infinite if it diverged
+
+  /**
+   * @brief Get the fraction of samples that did not diverge, including
+   * those still settling when the horizon ended
+   *
+   * @return double in [0, 1]
+   */
+  double get_stability_rate() const;
+
+  /**
+   * @brief Get the fraction of samples that settled
+   *
+   * @return double in [0, 1], at most get_stability_rate()
+   */
+  double get_settled_rate() const;
+};
+
+/**
+ * @brief Monte Carlo robustness analysis of one gain set.
+ *
+ * Draws options.samples plants from the distribution and runs a closed-loop
+ * step response against each, ClosedLoopSimulator::kChunkSize samples at a
+ * time in lockstep. Every chunk draws its plants from its own random
+ * stream seeded from options.seed and the chunk index, and the chunks are
+ * spread over a fixed number of partial reports that are merged in order,
+ * so the report does not depend on the thread count. Only the metrics are
+ * aggregated; no trajectories are kept. Throws std::invalid_argument for
+ * zero samples, a bad spread or a plant that cannot be discretized.
+ *
+ * @param gains controller gains, limits and sampling time
+ * @param plants plant distribution
+ * @param options analysis settings
+ * @return RobustnessReport
+ */
+RobustnessReport analyze_robustness(
+    const GainSet& gains, const PlantDistribution& plants,
+    const RobustnessOptions& options = RobustnessOptions());
+
+#endif  // INCLUDE_ROBUSTNESS_HPP_
@@ -0,0 +1,180 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_SENSOR_INGEST_HPP_
+#define INCLUDE_SENSOR_INGEST_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <pid.hpp>
+#include <seqlock.hpp>
+#include <spsc_ring.hpp>
+
+/**
+ * @brief One time-stamped measurement published by a sensor thread
+ *
+ */
+struct SensorSample {
+  double timestamp;  // seconds, increasing per channel
+  double measured;
+};
+
+/**
+ * @brief How a channel hands samples to the control thread
+ *
+ */
+enum class IngestMode {
+  queue,  // every sample is kept and computed, in order; full queue drops
+  latest  // only the newest sample is computed, older ones are overwritten
+};
+
+/**
+ * @brief Counters of one channel
+ *
+ */
+struct IngestStats {
+  uint64_t computed;      // compute() calls made for the channel
+  uint64_t dropped;       // samples rejected because the queue was full
+  uint64_t overwritten;   // samples replaced before they were computed
+  uint64_t out_of_order;  // samples skipped for a timestamp not after the
+                          // previous one
+};
+
+/**
+ * @brief Sensor-to-controller pipeline stage. Each channel connects one
+ * producer thread to one PIDController through a lock-free SPSC ring
+ * buffer or a seqlock holding the latest sample, padded so producers and
+ * the control thread do not share cache lines.
+ *
+ * The control thread calls drain() once per tick. It empties every channel
+ * in batches, taking at most one queue capacity of samples per channel per
+ * tick, and runs compute_with_dt() once per sample, over the time elapsed
+ * since the previous sample of that channel. Nothing blocks and nothing
+ * wakes up per sample.
+ *
+ * Channels are added before the producer threads start. A producer may
+ * feed several channels but a channel has exactly one producer.
+ *
+ */
+class SensorIngest {
+ public:
+  /**
+   * @brief Construct a new SensorIngest object
+   *
+   * @param queue_capacity slots per queue channel, rounded up to a power of
+   *        two
+   */
+  explicit SensorIngest(std::size_t queue_capacity = 256);
+
+  SensorIngest(const SensorIngest&) = delete;
+  SensorIngest& operator=(const SensorIngest&) = delete;
+
+  /**
+   * @brief Add a channel. The first sample of the channel is computed over
+   * controller->get_dt().
+   *
+   * @param controller controller fed by the channel, must outlive this
+   * @param setpoint initial setpoint
+   * @param mode queue or latest
+   * @return std::size_t channel index
+   */
+  std::size_t add_channel(PIDController* controller, double setpoint,
+                          IngestMode mode);
+
+  /**
+   * @brief Get the number of channels
+   *
+   * @return std::size_t
+   */
+  std::size_t get_channel_count() const;
+
+  /**
+   * @brief Publish a sample. Producer side; never blocks.
+   *
+   * @param channel channel index
+   * @param sample time-stamped measurement
+   * @return bool false if a queue channel was full and the sample dropped
+   */
+  bool publish(std::size_t channel, const SensorSample& sample);
+
+  /**
+   * @brief Set the setpoint used for the following samples. Control
+   * thread only.
+   *
+   * @param channel channel index
+   * @param setpoint target value
+   */
+  void set_setpoint(std::size_t channel, double setpoint);
+
+  /**
+   * @brief Compute the pending samples of every channel, at most one queue
+   * capacity per channel; the rest wait for the next tick. Control thread
+   * only.
+   *
+   * @param outputs receives, per channel, the output of its latest compute
+   *        (held from earlier ticks if nothing arrived); may be nullptr
+   * @return std::size_t number of compute() calls made
+   */
+  std::size_t drain(double* outputs);
+
+  /**
+   * @brief Get the output of the latest compute of a channel
+   *
+   * @param channel channel index
+   * @return double 0 before the first sample
+   */
+  double get_output(std::size_t channel) const;
+
+  /**
+   * @brief Get the counters of a channel. Safe from any thread.
+   *
+   * @param channel channel index
+   * @return IngestStats
+   */
+  IngestStats get_stats(std::size_t channel) const;
+
+ private:
+  static constexpr std::size_t kCacheLine = 64;
+  static constexpr std::size_t kBatchSize = 64;
+
+  struct Channel {
+    // Owned by the control thread.
+    PIDController* controller;
+    IngestMode mode;
+    bool has_timestamp;
+    double setpoint;
+    double last_timestamp;
+    uint64_t last_version;
+    double output;
+    std::atomic<uint64_t> computed;
+    std::atomic<uint64_t> overwritten;
+    std::atomic<uint64_t> out_of_order;
+    char consumer_pad[kCacheLine];
+
+    // Written by the producer.
+    std::unique_ptr<SpscRingBuffer<SensorSample> > queue;
+    Seqlock<SensorSample> latest;
+    char producer_pad[kCacheLine];
+  };
+
+  void check_channel(std::size_t channel) const;
+  void compute_sample(Channel* channel, const SensorSample& sample);
+
+  std::size_t queue_capacity;
+  std::vector<std::unique_ptr<Channel> > channels;
+  std::vector<SensorSample> batch;
+};
+
+#endif  // INCLUDE_SENSOR_INGEST_HPP_
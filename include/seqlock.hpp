@@ -0,0 +1,110 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_SEQLOCK_HPP_
+#define INCLUDE_SEQLOCK_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Single-writer sequence lock holding one value of type T.
+ * The writer never waits. A reader never waits either: if it races with a
+ * write, try_read() reports failure and the reader simply tries again
+ * later (for a control loop, on the next tick).
+ *
+ * The value is stored as relaxed atomic words so concurrent reads and
+ * writes are well defined.
+ *
+ * @tparam T trivially copyable value type
+ */
+template <typename T>
+class Seqlock {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Seqlock requires a trivially copyable type.");
+
+  Seqlock() : sequence(0) {
+    for (std::size_t i = 0; i < kWords; ++i) {
+      words[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  Seqlock(const Seqlock&) = delete;
+  Seqlock& operator=(const Seqlock&) = delete;
+
+  /**
+   * @brief Publish a new value. Only one thread may write.
+   *
+   * @param value value to publish
+   */
+  void write(const T& value) {
+    uint64_t buffer[kWords] = {};
+    std::memcpy(buffer, &value, sizeof(T));
+    const uint64_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < kWords; ++i) {
+      words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Read the value if no write is in progress
+   *
+   * @param value destination, untouched on failure
+   * @param version receives the version of the value read (0 = never
+   *        written); may be nullptr
+   * @return true if a consistent value was read
+   */
+  bool try_read(T* value, uint64_t* version) const {
+    const uint64_t before = sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+      return false;
+    }
+    uint64_t buffer[kWords];
+    for (std::size_t i = 0; i < kWords; ++i) {
+      buffer[i] = words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(value, buffer, sizeof(T));
+    if (version != nullptr) {
+      *version = before / 2;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Get the version of the last completed write (0 = never written).
+   * Cheap enough to poll every tick.
+   *
+   * @return uint64_t
+   */
+  uint64_t get_version() const {
+    return sequence.load(std::memory_order_acquire) / 2;
+  }
+
+ private:
+  static constexpr std::size_t kWords =
+      (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  std::atomic<uint64_t> sequence;
+  std::atomic<uint64_t> words[kWords];
+};
+
+#endif  // INCLUDE_SEQLOCK_HPP_
@@ -0,0 +1,223 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_SHM_CONTROLLER_HPP_
+#define INCLUDE_SHM_CONTROLLER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gain_update.hpp>
+#include <pid.hpp>
+
+struct ShmSegment;
+
+/**
+ * @brief Requests a client may have outstanding per slot
+ *
+ */
+const uint32_t kShmRingCapacity = 16;
+
+/**
+ * @brief Hosts one PIDController per slot for client processes on the same
+ * machine, through a POSIX shared-memory segment instead of sockets.
+ *
+ * Every slot holds a ring of kShmRingCapacity requests (setpoint and
+ * measured value) written by its client, and the matching outputs written
+ * by the server. Both sides read and write the segment directly; there is
+ * no serialization and no copy through the kernel. A sleeping server is
+ * woken through a futex on the segment doorbell, and a waiting client
+ * through a futex on its slot's completion counter. Linux only.
+ *
+ */
+class ShmControllerServer {
+ public:
+  /**
+   * @brief Create the segment, replacing a stale one of the same name,
+   * i.e. one whose server has stopped or no longer exists. Throws
+   * std::invalid_argument for a bad name or gain set and
+   * std::runtime_error if a live server owns the name or the segment
+   * cannot be created.
+   *
+   * @param name POSIX shared-memory name, e.g. "/pid-server"
+   * @param gains one gain set per slot, dt > 0
+   */
+  ShmControllerServer(const std::string& name,
+                      const std::vector<GainSet>& gains);
+
+  /**
+   * @brief Stop serving, unmap and remove the segment
+   *
+   */
+  ~ShmControllerServer();
+
+  ShmControllerServer(const ShmControllerServer&) = delete;
+  ShmControllerServer& operator=(const ShmControllerServer&) = delete;
+
+  /**
+   * @brief Answer every pending request once, without blocking. Not while
+   * serve() is running.
+   *
+   * @return std::size_t number of requests answered
+   */
+  std::size_t poll();
+
+  /**
+   * @brief Answer requests on the calling thread until stop(), sleeping on
+   * the doorbell when idle. Also usable in a child process after fork().
+   *
+   */
+  void serve();
+
+  /**
+   * @brief Run serve() on a background thread
+   *
+   */
+  void start();
+
+  /**
+   * @brief Stop serving and join the background thread. Clients waiting
+   * for an output get std::runtime_error. Final: the server cannot be
+   * restarted.
+   *
+   */
+  void stop();
+
+  /**
+   * @brief Set how many empty polls serve() makes before it sleeps. Spinning
+   * lowers latency when the server has a core to itself.
+   *
+   * @param iterations polls before sleeping
+   */
+  void set_spin(unsigned iterations);
+
+  /**
+   * @brief Get the number of slots
+   *
+   * @return std::size_t
+   */
+  std::size_t get_slot_count() const;
+
+  /**
+   * @brief Get the number of requests answered so far
+   *
+   * @return uint64_t
+   */
+  uint64_t get_served() const;
+
+ private:
+  std::string name;
+  std::size_t length;
+  ShmSegment* segment;
+  std::vector<PIDController> controllers;
+  unsigned spin;
+  std::atomic<uint64_t> served;
+  std::thread worker;
+};
+
+/**
+ * @brief Client side of a ShmControllerServer slot. Requests may be
+ * pipelined: up to kShmRingCapacity can be submitted before their outputs
+ * are received, and outputs come back in submission order.
+ *
+ */
+class ShmControllerClient {
+ public:
+  /**
+   * @brief Attach to a slot. Throws std::runtime_error if the segment does
+   * not exist or the slot is taken by another client, std::out_of_range for
+   * an unknown slot.
+   *
+   * @param name name the server was created with
+   * @param slot slot index, < get_slot_count()
+   */
+  ShmControllerClient(const std::string& name, std::size_t slot);
+
+  /**
+   * @brief Release the slot and unmap the segment
+   *
+   */
+  ~ShmControllerClient();
+
+  ShmControllerClient(const ShmControllerClient&) = delete;
+  ShmControllerClient& operator=(const ShmControllerClient&) = delete;
+
+  /**
+   * @brief Queue one request without waiting
+   *
+   * @param setpoint_value target value of the parameter
+   * @param measured_value current measured estimate of the parameter
+   * @return bool false if kShmRingCapacity outputs are still unreceived,
+   *         or, after taking over a slot, while the server is still
+   *         answering kShmRingCapacity requests of the previous client
+   */
+  bool submit(double setpoint_value, double measured_value);
+
+  /**
+   * @brief Get the output of the oldest unreceived request if it is ready
+   *
+   * @param output receives the controller output
+   * @return bool true if an output was received
+   */
+  bool try_receive(double* output);
+
+  /**
+   * @brief Wait for the output of the oldest unreceived request. Throws
+   * std::logic_error if nothing is outstanding and std::runtime_error if
+   * the server stops.
+   *
+   * @return double
+   */
+  double receive();
+
+  /**
+   * @brief Submit one request and wait for its output, like
+   * PIDController::compute(). Throws std::logic_error if earlier requests
+   * are still outstanding. After taking over a slot, first waits for the
+   * server to make room by answering the previous client's requests.
+   *
+   * @param setpoint_value target value of the parameter
+   * @param measured_value current measured estimate of the parameter
+   * @return double
+   */
+  double compute(double setpoint_value, double measured_value);
+
+  /**
+   * @brief Set how many times receive() checks for the output before it
+   * sleeps on the futex
+   *
+   * @param iterations checks before sleeping
+   */
+  void set_spin(unsigned iterations);
+
+  /**
+   * @brief Get the number of slots of the server
+   *
+   * @return std::size_t
+   */
+  std::size_t get_slot_count() const;
+
+ private:
+  bool server_alive() const;
+
+  std::size_t length;
+  ShmSegment* segment;
+  std::size_t slot;
+  uint32_t submitted;
+  uint32_t received;
+  unsigned spin;
+};
+
+#endif  // INCLUDE_SHM_CONTROLLER_HPP_
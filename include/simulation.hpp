@@ -0,0 +1,157 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_SIMULATION_HPP_
+#define INCLUDE_SIMULATION_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <gain_update.hpp>
+#include <pid.hpp>
+#include <plant.hpp>
+
+/**
+ * @brief Closed-loop step-response experiment. The plant starts at rest and
+ * the setpoint steps from 0 to setpoint at t = 0.
+ *
+ */
+struct SimulationOptions {
+  double setpoint = 1.0;          // step size, != 0
+  std::size_t steps = 1000;       // number of controller ticks
+  double settling_band = 0.02;    // fraction of the setpoint
+  double divergence_limit = 1e3;  // abort once |y / setpoint| exceeds it
+  bool record_trajectory = false;
+};
+
+/**
+ * @brief Step-response metrics of one simulation. Times are in seconds and
+ * are infinite when never reached.
+ *
+ */
+struct StepResponseMetrics {
+  double rise_time;      // 10 % to 90 % of the setpoint
+  double overshoot;      // peak above the setpoint, in percent
+  double settling_time;  // time after which y stays inside the band
+  double iae;            // integral of |error|, infinite when diverged
+  double ise;            // integral of error^2, infinite when diverged
+  double final_value;    // last plant output
+  bool settled;
+  bool diverged;
+};
+
+/**
+ * @brief Run one closed-loop step response. The controller keeps its state
+ * from earlier calls and its dt is used as the sampling time.
+ *
+ * @param controller controller in the loop
+ * @param plant plant description
+ * @param options experiment settings
+ * @param trajectory receives the plant output of every tick when not null
+ * @return StepResponseMetrics
+ */
+StepResponseMetrics simulate_step_response(PIDController* controller,
+                                           const PlantParams& plant,
+                                           const SimulationOptions& options,
+                                           std::vector<double>* trajectory =
+                                               nullptr);
+
+/**
+ * @brief Run one closed-loop step response on an existing plant, without
+ * allocating unless a trajectory is requested. Both the controller and the
+ * plant continue from their current state; reset them to start from rest.
+ * Throws std::invalid_argument if their sampling times differ.
+ *
+ * @param controller controller in the loop
+ * @param plant plant in the loop, discretized at the controller's dt
+ * @param options experiment settings
+ * @param trajectory receives the plant output of every tick when not null
+ * @return StepResponseMetrics
+ */
+StepResponseMetrics simulate_step_response(PIDController* controller,
+                                           DiscretePlant* plant,
+                                           const SimulationOptions& options,
+                                           std::vector<double>* trajectory =
+                                               nullptr);
+
+/**
+ * @brief Runs many independent closed-loop step responses.
+ *
+ * Gains and discretized plants are kept as parallel arrays. run() splits
+ * the simulations into chunks that are distributed over threads; inside a
+ * chunk every simulation advances in lockstep, the controllers through one
+ * PIDControllerBank::compute() call per tick and the plants through a flat
+ * loop over their state arrays. Only the running metrics are kept per
+ * simulation unless trajectories are requested.
+ *
+ */
+class ClosedLoopSimulator {
+ public:
+  /**
+   * @brief Number of simulations advanced together by one thread
+   *
+   */
+  static const std::size_t kChunkSize = 256;
+
+  /**
+   * @brief Add one simulation. Throws std::invalid_argument when the plant
+   * cannot be discretized at gains.dt.
+   *
+   * @param gains controller gains, limits and sampling time
+   * @param plant plant description
+   * @return std::size_t index of the simulation
+   */
+  std::size_t add(const GainSet& gains, const PlantParams& plant);
+
+  /**
+   * @brief Get the number of simulations
+   *
+   * @return std::size_t
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Run every simulation from rest
+   *
+   * @param options experiment settings shared by all simulations
+   * @param threads number of threads, 0 for one per core
+   * @return std::vector<StepResponseMetrics> metrics per simulation
+   */
+  std::vector<StepResponseMetrics> run(const SimulationOptions& options,
+                                       unsigned threads = 0);
+
+  /**
+   * @brief Get the plant outputs recorded by the last run(). Throws
+   * std::out_of_range for a bad index and std::logic_error when the last
+   * run did not record trajectories.
+   *
+   * @param index simulation index
+   * @return const std::vector<double>&
+   */
+  const std::vector<double>& get_trajectory(std::size_t index) const;
+
+ private:
+  void run_chunk(std::size_t begin, std::size_t end,
+                 const SimulationOptions& options,
+                 StepResponseMetrics* metrics);
+
+  std::vector<GainSet> gains;
+  std::vector<double> a11;
+  std::vector<double> a12;
+  std::vector<double> a21;
+  std::vector<double> a22;
+  std::vector<double> b1;
+  std::vector<double> b2;
+  std::vector<std::size_t> delay_samples;
+  std::vector<std::vector<double> > trajectories;
+};
+
+#endif  // INCLUDE_SIMULATION_HPP_
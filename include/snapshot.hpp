@@ -0,0 +1,224 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_SNAPSHOT_HPP_
+#define INCLUDE_SNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <pid.hpp>
+#include <pid_bank.hpp>
+
+/**
+ * @brief Header of a snapshot file, followed by count SnapshotRecords, all
+ * in host byte order. sequence is 0 until the first save, odd while a save
+ * is in progress and even once it is complete.
+ *
+ */
+struct SnapshotHeader {
+  char magic[8];  // "PIDSNAPS"
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t count;
+  uint64_t sequence;
+  uint64_t reserved[4];
+};
+
+/**
+ * @brief Saved parameters and state of one controller; one cache line
+ *
+ */
+struct SnapshotRecord {
+  double kP;
+  double kI;
+  double kD;
+  double max_value;
+  double min_value;
+  double dt;
+  double integral_sum;
+  double prev_error;
+};
+
+/**
+ * @brief Fixed-size controller snapshot kept in a shared memory-mapped
+ * file, so a restarted process resumes with its integral sums and previous
+ * errors instead of re-converging from zero.
+ *
+ * Saving writes straight into the mapping, with no allocation and no
+ * system call; the kernel writes the pages back, and they survive the
+ * process crashing. Call flush() when they must also survive power loss.
+ * Restoring reads the records in place. The controllers resume
+ * bit-identically to ones that never stopped.
+ *
+ */
+class ControllerSnapshot {
+ public:
+  static constexpr uint32_t kVersion = 1;
+
+  /**
+   * @brief Create or overwrite a snapshot file for count controllers.
+   * Throws std::runtime_error on I/O errors.
+   *
+   * @param path file to create
+   * @param count number of controllers, > 0
+   */
+  ControllerSnapshot(const std::string& path, std::size_t count);
+
+  /**
+   * @brief Open an existing snapshot file to restore from and keep saving
+   * to. Throws std::runtime_error on I/O errors or if the file is not a
+   * snapshot of this version.
+   *
+   * @param path file to open
+   */
+  explicit ControllerSnapshot(const std::string& path);
+
+  /**
+   * @brief Destroy the ControllerSnapshot object and unmap the file
+   *
+   */
+  ~ControllerSnapshot();
+
+  ControllerSnapshot(const ControllerSnapshot&) = delete;
+  ControllerSnapshot& operator=(const ControllerSnapshot&) = delete;
+
+  /**
+   * @brief Get the number of controllers in the snapshot
+   *
+   * @return std::size_t
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Get the number of completed saves since the file was created
+   *
+   * @return uint64_t
+   */
+  uint64_t get_save_count() const;
+
+  /**
+   * @brief Check that the snapshot was saved at least once and that no
+   * save was interrupted
+   *
+   * @return bool
+   */
+  bool is_complete() const;
+
+  /**
+   * @brief Get one saved record
+   *
+   * @param index controller index, < size()
+   * @return const SnapshotRecord&
+   */
+  const SnapshotRecord& get_record(std::size_t index) const;
+
+  /**
+   * @brief Save one controller. This only completes a save on a snapshot
+   * that is already complete; on a fresh or interrupted one the record is
+   * written but the snapshot stays incomplete until a whole-set save.
+   *
+   * @param index controller index, < size()
+   * @param controller controller to save
+   */
+  void save(std::size_t index, const PIDController& controller);
+
+  /**
+   * @brief Save size() controllers stored contiguously. Completes a fresh
+   * or interrupted snapshot.
+   *
+   * @param controllers first of size() controllers
+   * @param count number of controllers, must equal size()
+   */
+  void save(const PIDController* controllers, std::size_t count);
+
+  /**
+   * @brief Save every controller of a bank. Completes a fresh or
+   * interrupted snapshot.
+   *
+   * @param bank bank with size() controllers
+   */
+  void save(const PIDControllerBank& bank);
+
+  /**
+   * @brief Set how many tick() calls there are between saves
+   *
+   * @param ticks save every ticks calls, > 0
+   */
+  void set_interval(unsigned ticks);
+
+  /**
+   * @brief Count one control tick and save the controllers every
+   * set_interval() ticks, starting with the first call
+   *
+   * @param controllers first of size() controllers
+   * @param count number of controllers, must equal size()
+   * @return bool true if this call saved
+   */
+  bool tick(const PIDController* controllers, std::size_t count);
+
+  /**
+   * @brief Same as tick() for the controllers of a bank
+   *
+   * @param bank bank with size() controllers
+   * @return bool true if this call saved
+   */
+  bool tick(const PIDControllerBank& bank);
+
+  /**
+   * @brief Restore one controller. Throws std::runtime_error unless
+   * is_complete().
+   *
+   * @param index controller index, < size()
+   * @param controller controller to overwrite
+   */
+  void restore(std::size_t index, PIDController* controller) const;
+
+  /**
+   * @brief Restore size() controllers stored contiguously
+   *
+   * @param controllers first of size() controllers
+   * @param count number of controllers, must equal size()
+   */
+  void restore(PIDController* controllers, std::size_t count) const;
+
+  /**
+   * @brief Restore a bank. An empty bank gets size() controllers added,
+   * otherwise its size must equal size().
+   *
+   * @param bank bank to overwrite
+   */
+  void restore(PIDControllerBank* bank) const;
+
+  /**
+   * @brief Write the mapped pages to disk and wait for completion
+   *
+   */
+  void flush();
+
+ private:
+  void map(int fd, const std::string& path);
+  void check_index(std::size_t index) const;
+  void check_count(std::size_t count) const;
+  void check_complete() const;
+  void begin_save();
+  void end_save();
+
+  void* address;
+  std::size_t length;
+  SnapshotHeader* header;
+  SnapshotRecord* records;
+  unsigned interval;
+  unsigned countdown;
+};
+
+#endif  // INCLUDE_SNAPSHOT_HPP_
@@ -0,0 +1,159 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_SPSC_RING_HPP_
+#define INCLUDE_SPSC_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring buffer.
+ * Exactly one thread may push and exactly one (other) thread may pop.
+ * Neither side ever blocks: a push into a full buffer is dropped and
+ * counted instead.
+ *
+ * @tparam T trivially copyable element type
+ */
+template <typename T>
+class SpscRingBuffer {
+ public:
+  /**
+   * @brief Construct a new SpscRingBuffer object
+   *
+   * @param capacity number of slots, rounded up to the next power of two
+   */
+  explicit SpscRingBuffer(std::size_t capacity)
+      : head(0), cached_tail(0), dropped(0), tail(0), cached_head(0) {
+    if (capacity == 0) {
+      throw std::invalid_argument("capacity should be greater than 0.");
+    }
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    buffer.resize(rounded);
+    mask = rounded - 1;
+  }
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  /**
+   * @brief Append an element. Producer side only.
+   *
+   * @param item element to copy into the buffer
+   * @return true if stored, false if the buffer was full
+   */
+  bool try_push(const T& item) {
+    const std::size_t h = head.load(std::memory_order_relaxed);
+    if (h - cached_tail > mask) {
+      cached_tail = tail.load(std::memory_order_acquire);
+      if (h - cached_tail > mask) {
+        dropped.store(dropped.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+        return false;
+      }
+    }
+    buffer[h & mask] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Remove the oldest element. Consumer side only.
+   *
+   * @param item destination for the element
+   * @return true if an element was popped, false if the buffer was empty
+   */
+  bool try_pop(T* item) {
+    return pop_batch(item, 1) == 1;
+  }
+
+  /**
+   * @brief Remove up to max_items of the oldest elements. Consumer side only.
+   *
+   * @param items destination array of at least max_items elements
+   * @param max_items maximum number of elements to pop
+   * @return std::size_t number of elements popped
+   */
+  std::size_t pop_batch(T* items, std::size_t max_items) {
+    const std::size_t t = tail.load(std::memory_order_relaxed);
+    std::size_t available = cached_head - t;
+    if (available < max_items) {
+      cached_head = head.load(std::memory_order_acquire);
+      available = cached_head - t;
+    }
+    const std::size_t count = available < max_items ? available : max_items;
+    for (std::size_t i = 0; i < count; ++i) {
+      items[i] = buffer[(t + i) & mask];
+    }
+    tail.store(t + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * @brief Get the number of slots in the buffer
+   *
+   * @return std::size_t
+   */
+  std::size_t capacity() const {
+    return mask + 1;
+  }
+
+  /**
+   * @brief Get the number of queued elements. Only a hint while the
+   * other side is running.
+   *
+   * @return std::size_t
+   */
+  std::size_t size() const {
+    return head.load(std::memory_order_acquire) -
+           tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get the number of pushes rejected because the buffer was full
+   *
+   * @return uint64_t
+   */
+  uint64_t get_dropped() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr std::size_t kCacheLine = 64;
+
+  // Read-only after construction, shared by both sides.
+  std::vector<T> buffer;
+  std::size_t mask;
+
+  // The object is only as aligned as the allocator makes it, so the pads
+  // are whole lines: whatever the base address, the producer and consumer
+  // fields never share a line with each other or with a neighbour.
+  char leading_pad[kCacheLine];
+
+  // Written by the producer.
+  std::atomic<std::size_t> head;
+  std::size_t cached_tail;
+  std::atomic<uint64_t> dropped;
+  char producer_pad[kCacheLine];
+
+  // Written by the consumer.
+  std::atomic<std::size_t> tail;
+  std::size_t cached_head;
+  char consumer_pad[kCacheLine];
+};
+
+#endif  // INCLUDE_SPSC_RING_HPP_
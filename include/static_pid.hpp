@@ -0,0 +1,339 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_STATIC_PID_HPP_
+#define INCLUDE_STATIC_PID_HPP_
+
+#include <stdexcept>
+#include <utility>
+
+#include <pid.hpp>
+
+/**
+ * @brief Compile-time policies for StaticPIDController
+ *
+ */
+namespace pid_policy {
+
+/**
+ * @brief Clamp the output to [min_value, max_value], like PIDController
+ *
+ */
+struct Clamp {
+  template <typename Scalar>
+  static Scalar apply(Scalar output, Scalar min_value, Scalar max_value) {
+    if (output > max_value) {
+      return max_value;
+    } else if (output < min_value) {
+      return min_value;
+    }
+    return output;
+  }
+};
+
+/**
+ * @brief Leave the output unbounded; the limits are ignored
+ *
+ */
+struct NoClamp {
+  template <typename Scalar>
+  static Scalar apply(Scalar output, Scalar, Scalar) {
+    return output;
+  }
+};
+
+/**
+ * @brief Always integrate the error, like PIDController
+ *
+ */
+struct NoAntiWindup {
+  template <typename Scalar>
+  static Scalar integral(Scalar, Scalar updated, Scalar, Scalar, Scalar) {
+    return updated;
+  }
+};
+
+/**
+ * @brief Conditional integration: while the output is clamped, drop the
+ * integration step if it would drive the output further into saturation
+ *
+ */
+struct ConditionalIntegration {
+  template <typename Scalar>
+  static Scalar integral(Scalar previous, Scalar updated, Scalar output,
+                         Scalar clamped_output, Scalar error) {
+    if ((output > clamped_output && error > Scalar(0)) ||
+        (output < clamped_output && error < Scalar(0))) {
+      return previous;
+    }
+    return updated;
+  }
+};
+
+/**
+ * @brief Differentiate the error, like PIDController, whose first sample
+ * differentiates against a zero previous error
+ *
+ */
+struct DerivativeOnError {
+  static constexpr bool kSeedFromFirstSample = false;
+
+  template <typename Scalar>
+  static Scalar signal(Scalar error, Scalar) {
+    return error;
+  }
+};
+
+/**
+ * @brief Differentiate the negated measurement, which avoids the derivative
+ * kick on setpoint steps. The first sample after construction or reset()
+ * seeds the history, so it has no kick from the measurement either.
+ *
+ */
+struct DerivativeOnMeasurement {
+  static constexpr bool kSeedFromFirstSample = true;
+
+  template <typename Scalar>
+  static Scalar signal(Scalar, Scalar measured_value) {
+    return -measured_value;
+  }
+};
+
+}  // namespace pid_policy
+
+/**
+ * @brief Gains, limits and sampling time held as data members and
+ * changeable at runtime. kD / dt is cached so compute() does not divide.
+ *
+ * @tparam Scalar arithmetic type of the controller
+ */
+template <typename Scalar>
+class RuntimeGains {
+ public:
+  RuntimeGains(Scalar kP, Scalar kI, Scalar kD, Scalar max_value,
+               Scalar min_value, Scalar dt)
+      : kP(kP), kI(kI), kD(kD), max_value(max_value), min_value(min_value),
+        dt(dt), kD_over_dt(0) {
+    if (dt <= Scalar(0)) {
+      throw std::invalid_argument("dt should be greater than 0.");
+    }
+    kD_over_dt = kD / dt;
+  }
+
+  Scalar get_kP() const { return kP; }
+  Scalar get_kI() const { return kI; }
+  Scalar get_kD() const { return kD; }
+  Scalar get_max_value() const { return max_value; }
+  Scalar get_min_value() const { return min_value; }
+  Scalar get_dt() const { return dt; }
+  Scalar get_kD_over_dt() const { return kD_over_dt; }
+
+  void set_kP(Scalar kp) { kP = kp; }
+  void set_kI(Scalar ki) { kI = ki; }
+  void set_kD(Scalar kd) {
+    kD = kd;
+    kD_over_dt = kD / dt;
+  }
+  void set_max_value(Scalar maxValue) { max_value = maxValue; }
+  void set_min_value(Scalar minValue) { min_value = minValue; }
+  void set_dt(Scalar dT) {
+    if (dT <= Scalar(0)) {
+      throw std::invalid_argument("dt should be greater than 0.");
+    }
+    dt = dT;
+    kD_over_dt = kD / dt;
+  }
+
+ private:
+  Scalar kP;
+  Scalar kI;
+  Scalar kD;
+  Scalar max_value;
+  Scalar min_value;
+  Scalar dt;
+  Scalar kD_over_dt;
+};
+
+/**
+ * @brief Gains, limits and sampling time fixed at compile time. Params is
+ * a struct with static constexpr double members kP, kI, kD, max_value,
+ * min_value and dt; the controller then stores no gains at all and the
+ * compiler folds them into the update.
+ *
+ * @tparam Scalar arithmetic type of the controller
+ * @tparam Params compile-time parameter set
+ */
+template <typename Scalar, typename Params>
+class FixedGains {
+ public:
+  static_assert(Params::dt > 0, "dt should be greater than 0.");
+
+  static constexpr Scalar get_kP() { return Scalar(Params::kP); }
+  static constexpr Scalar get_kI() { return Scalar(Params::kI); }
+  static constexpr Scalar get_kD() { return Scalar(Params::kD); }
+  static constexpr Scalar get_max_value() { return Scalar(Params::max_value); }
+  static constexpr Scalar get_min_value() { return Scalar(Params::min_value); }
+  static constexpr Scalar get_dt() { return Scalar(Params::dt); }
+  static constexpr Scalar get_kD_over_dt() {
+    return Scalar(Params::kD / Params::dt);
+  }
+};
+
+/**
+ * @brief Header-only PID controller whose behaviour is selected at compile
+ * time. Nothing is virtual, so compute() inlines into the calling loop.
+ * With the default policies it follows the same equations as PIDController.
+ *
+ * @tparam Scalar arithmetic type of the controller
+ * @tparam Gains RuntimeGains<Scalar> or FixedGains<Scalar, Params>
+ * @tparam Clamping pid_policy::Clamp or pid_policy::NoClamp
+ * @tparam AntiWindup pid_policy::NoAntiWindup or
+ *         pid_policy::ConditionalIntegration
+ * @tparam Derivative pid_policy::DerivativeOnError or
+ *         pid_policy::DerivativeOnMeasurement
+ */
+template <typename Scalar, typename Gains = RuntimeGains<Scalar>,
+          typename Clamping = pid_policy::Clamp,
+          typename AntiWindup = pid_policy::NoAntiWindup,
+          typename Derivative = pid_policy::DerivativeOnError>
+class StaticPIDController : public Gains {
+ public:
+  typedef Scalar scalar_type;
+
+  /**
+   * @brief Construct a new StaticPIDController object with FixedGains
+   *
+   */
+  StaticPIDController()
+      : Gains(), integral_sum(0), prev_signal(0), started(false) {
+  }
+
+  /**
+   * @brief Construct a new StaticPIDController object with RuntimeGains
+   *
+   * @param kP proportional gain
+   * @param kI integral gain
+   * @param kD differential gain
+   * @param max_value maximum value that the parameter (ex: velocity) can have
+   * @param min_value minimum value that the parameter (ex: velocity) can have
+   * @param dt sampling time
+   */
+  StaticPIDController(Scalar kP, Scalar kI, Scalar kD, Scalar max_value,
+                      Scalar min_value, Scalar dt)
+      : Gains(kP, kI, kD, max_value, min_value, dt),
+        integral_sum(0),
+        prev_signal(0),
+        started(false) {
+  }
+
+  /**
+   * @brief To find the controller output value based on the target
+   * setpoint and measured values
+   *
+   * @param setpoint_value target value of the parameter
+   * @param measured_value current measured estimate of the parameter
+   * @return Scalar
+   */
+  Scalar compute(Scalar setpoint_value, Scalar measured_value) {
+    const Scalar error = setpoint_value - measured_value;
+    const Scalar signal = Derivative::signal(error, measured_value);
+    if (Derivative::kSeedFromFirstSample && !started) {
+      prev_signal = signal;
+    }
+    started = true;
+    const Scalar updated_sum = integral_sum + error * this->get_dt();
+    const Scalar output = this->get_kP() * error +
+                          this->get_kI() * updated_sum +
+                          this->get_kD_over_dt() * (signal - prev_signal);
+    const Scalar clamped = Clamping::apply(output, this->get_min_value(),
+                                           this->get_max_value());
+    integral_sum = AntiWindup::integral(integral_sum, updated_sum, output,
+                                        clamped, error);
+    prev_signal = signal;
+    return clamped;
+  }
+
+  /**
+   * @brief Get the integral_sum over time
+   *
+   * @return Scalar
+   */
+  Scalar get_integral_sum() const {
+    return integral_sum;
+  }
+
+  /**
+   * @brief Get the last value fed to the derivative term: the error, or the
+   * negated measurement with pid_policy::DerivativeOnMeasurement
+   *
+   * @return Scalar
+   */
+  Scalar get_prev_signal() const {
+    return prev_signal;
+  }
+
+  /**
+   * @brief Clear integral_sum and the derivative history
+   *
+   */
+  void reset() {
+    integral_sum = Scalar(0);
+    prev_signal = Scalar(0);
+    started = false;
+  }
+
+ private:
+  Scalar integral_sum;
+  Scalar prev_signal;
+  bool started;  // compute() has run since construction or reset()
+};
+
+/**
+ * @brief Exposes a StaticPIDController through PIDControllerInterface for
+ * code that needs runtime polymorphism. Only this wrapper's compute() is
+ * virtual; the wrapped update is still inlined inside it.
+ *
+ * @tparam Controller a StaticPIDController specialisation
+ */
+template <typename Controller>
+class StaticPIDControllerAdapter : public PIDControllerInterface {
+ public:
+  /**
+   * @brief Construct a new StaticPIDControllerAdapter object
+   *
+   * @param args forwarded to the Controller constructor
+   */
+  template <typename... Args>
+  explicit StaticPIDControllerAdapter(Args&&... args)
+      : controller(std::forward<Args>(args)...) {
+  }
+
+  double compute(double setpoint_value, double measured_value) override {
+    typedef typename Controller::scalar_type Scalar;
+    return static_cast<double>(controller.compute(
+        static_cast<Scalar>(setpoint_value),
+        static_cast<Scalar>(measured_value)));
+  }
+
+  /**
+   * @brief Get the wrapped controller
+   *
+   * @return Controller&
+   */
+  Controller& get_controller() {
+    return controller;
+  }
+
+ private:
+  Controller controller;
+};
+
+#endif  // INCLUDE_STATIC_PID_HPP_
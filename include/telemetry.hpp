@@ -0,0 +1,130 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_TELEMETRY_HPP_
+#define INCLUDE_TELEMETRY_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include <spsc_ring.hpp>
+
+/**
+ * @brief One fixed-size sample of the controller state, written per compute()
+ *
+ */
+struct TelemetryRecord {
+  uint64_t timestamp_ns;  // steady_clock time of the compute() call
+  double setpoint;
+  double measured;
+  double error;
+  double proportional;  // kP term
+  double integral;      // kI term
+  double derivative;    // kD term
+  double output;        // output after clamping
+  int32_t saturated;    // +1 clamped to max, -1 clamped to min, 0 otherwise
+  int32_t reserved;
+};
+
+/**
+ * @brief Ring buffer a PIDController publishes its TelemetryRecords into
+ *
+ */
+typedef SpscRingBuffer<TelemetryRecord> TelemetryRingBuffer;
+
+/**
+ * @brief Output format used by the TelemetryDrainer
+ *
+ */
+enum class TelemetryFormat {
+  binary,  // raw TelemetryRecord structs, back to back
+  csv      // one header line followed by one line per record
+};
+
+/**
+ * @brief Consumer side of a TelemetryRingBuffer. Drains records on a
+ * background thread (or on demand) and writes them to a stream, keeping all
+ * formatting and I/O off the control thread.
+ *
+ */
+class TelemetryDrainer {
+ public:
+  /**
+   * @brief Construct a new TelemetryDrainer object
+   *
+   * @param buffer ring buffer to consume, must outlive the drainer
+   * @param out stream the records are written to, must outlive the drainer
+   * @param format binary or csv output
+   * @param poll_interval sleep time of the background thread when idle
+   */
+  TelemetryDrainer(TelemetryRingBuffer* buffer, std::ostream* out,
+                   TelemetryFormat format,
+                   std::chrono::microseconds poll_interval =
+                       std::chrono::microseconds(1000));
+
+  /**
+   * @brief Destroy the TelemetryDrainer object. Stops the background thread
+   * and writes out whatever is still buffered.
+   *
+   */
+  ~TelemetryDrainer();
+
+  TelemetryDrainer(const TelemetryDrainer&) = delete;
+  TelemetryDrainer& operator=(const TelemetryDrainer&) = delete;
+
+  /**
+   * @brief Start the background drain thread
+   *
+   */
+  void start();
+
+  /**
+   * @brief Stop the background drain thread and flush the remaining records
+   *
+   */
+  void stop();
+
+  /**
+   * @brief Write out every record currently in the buffer.
+   * Must not be called while the background thread is running.
+   *
+   * @return std::size_t number of records written
+   */
+  std::size_t drain();
+
+  /**
+   * @brief Get the total number of records written so far
+   *
+   * @return uint64_t
+   */
+  uint64_t get_records_written() const;
+
+ private:
+  void write_records(const TelemetryRecord* records, std::size_t count);
+  void run();
+
+  TelemetryRingBuffer* buffer;
+  std::ostream* out;
+  TelemetryFormat format;
+  std::chrono::microseconds poll_interval;
+  bool header_written;
+  std::vector<TelemetryRecord> batch;
+  std::atomic<bool> running;
+  std::atomic<uint64_t> records_written;
+  std::thread worker;
+};
+
+#endif  // INCLUDE_TELEMETRY_HPP_
@@ -0,0 +1,133 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#ifndef INCLUDE_TRACE_REPLAY_HPP_
+#define INCLUDE_TRACE_REPLAY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gain_update.hpp>
+
+/**
+ * @brief One recorded controller input
+ *
+ */
+struct TraceSample {
+  double timestamp;
+  double setpoint;
+  double measured;
+};
+
+/**
+ * @brief Header of binary trace and replay output files.
+ * A binary trace is this header (magic "PIDTRACE", columns 3) followed by
+ * TraceSample records in host byte order. A binary replay output is this
+ * header (magic "PIDOUTPT", columns 1 + number of gain sets) followed by one
+ * row per sample: the timestamp, then one output per gain set.
+ *
+ */
+struct TraceHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t columns;
+};
+
+/**
+ * @brief Encoding of a trace or replay output file
+ *
+ */
+enum class TraceFormat {
+  binary,
+  csv  // "timestamp,setpoint,measured" lines; a header line is allowed
+};
+
+/**
+ * @brief Write samples as a binary trace file
+ *
+ * @param path file to create or overwrite
+ * @param samples samples to write
+ */
+void write_binary_trace(const std::string& path,
+                        const std::vector<TraceSample>& samples);
+
+/**
+ * @brief Read every sample of a binary or csv trace. Throws
+ * std::runtime_error on I/O or parse errors.
+ *
+ * @param path trace file
+ * @return std::vector<TraceSample>
+ */
+std::vector<TraceSample> read_trace(const std::string& path);
+
+/**
+ * @brief Replays recorded (timestamp, setpoint, measured) logs through one
+ * or more candidate gain sets.
+ *
+ * Input files are memory-mapped and read in place; the format is detected
+ * from the binary header. With one gain set a PIDController is used, with
+ * several a PIDControllerBank runs every candidate on the same sample in
+ * one call. Each sample is computed over the time since the previous one,
+ * so irregular logs replay as recorded; the first sample steps by the gain
+ * set's dt. Outputs are streamed to the output file through a large write
+ * buffer.
+ *
+ */
+class TraceReplayer {
+ public:
+  /**
+   * @brief Construct a new TraceReplayer object
+   *
+   * @param gain_sets candidate gains, at least one, each with dt > 0; dt
+   *        is only the step of the first sample
+   */
+  explicit TraceReplayer(const std::vector<GainSet>& gain_sets);
+
+  /**
+   * @brief Replay one log. Throws std::runtime_error on I/O or parse errors
+   * and on timestamps that do not increase.
+   *
+   * @param input_path binary or csv trace
+   * @param output_path file the outputs are written to
+   * @param output_format encoding of the output file
+   * @return uint64_t number of samples replayed
+   */
+  uint64_t replay(const std::string& input_path,
+                  const std::string& output_path,
+                  TraceFormat output_format) const;
+
+  /**
+   * @brief Replay many logs in parallel, one log per thread at a time
+   *
+   * @param jobs (input_path, output_path) pairs
+   * @param output_format encoding of the output files
+   * @param threads number of threads, 0 for one per core
+   * @return std::vector<uint64_t> samples replayed per job
+   */
+  std::vector<uint64_t> replay_all(
+      const std::vector<std::pair<std::string, std::string> >& jobs,
+      TraceFormat output_format, unsigned threads) const;
+
+  /**
+   * @brief Get the number of candidate gain sets
+   *
+   * @return std::size_t
+   */
+  std::size_t get_gain_set_count() const;
+
+ private:
+  std::vector<GainSet> gain_sets;
+};
+
+#endif  // INCLUDE_TRACE_REPLAY_HPP_
@@ -0,0 +1,371 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <autotune.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include <parallel.hpp>
+#include <pid.hpp>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+const double kInfinity = std::numeric_limits<double>::infinity();
+// Initial simplex edge: every gain doubled in turn.
+const double kSimplexStep = std::log(2.0);
+// Spread of the perturbed starting points, in natural-log units.
+const double kStartSpread = 1.0;
+
+typedef std::array<double, 3> Point;
+
+// Sign the gains need for negative feedback: a reverse-acting plant
+// (gain < 0) needs a reverse-acting controller.
+double plant_direction(const PlantParams& plant) {
+  return plant.gain < 0 ? -1.0 : 1.0;
+}
+
+/**
+ * @brief Scores candidate gains on one reused controller and plant
+ *
+ */
+class CandidateEvaluator {
+ public:
+  CandidateEvaluator(const PlantParams& plant, double dt,
+                     const TuningOptions& options)
+      : controller(1.0, 0.0, 0.0, options.max_value, options.min_value, dt),
+        plant(plant, dt), options(options),
+        direction(plant_direction(plant)), evaluations(0), rejected(0) {
+  }
+
+  // Gains are searched as logarithms of their magnitudes and take the sign
+  // of the plant gain, so the loop is always negative feedback.
+  double cost(const Point& x, StepResponseMetrics* metrics = nullptr) {
+    controller.set_kP(direction * std::exp(x[0]));
+    controller.set_kI(direction * std::exp(x[1]));
+    controller.set_kD(direction * std::exp(x[2]));
+    controller.reset();
+    plant.reset();
+    StepResponseMetrics result =
+        simulate_step_response(&controller, &plant, options.simulation);
+    ++evaluations;
+    if (result.diverged) {
+      ++rejected;
+    }
+    if (metrics != nullptr) {
+      *metrics = result;
+    }
+    return result.iae + options.overshoot_weight * result.overshoot / 100;
+  }
+
+  uint64_t get_evaluations() const {
+    return evaluations;
+  }
+
+  uint64_t get_rejected() const {
+    return rejected;
+  }
+
+ private:
+  PIDController controller;
+  DiscretePlant plant;
+  const TuningOptions& options;
+  double direction;
+  uint64_t evaluations;
+  uint64_t rejected;
+};
+
+struct Vertex {
+  Point x;
+  double cost;
+};
+
+Point blend(const Point& from, const Point& to, double t) {
+  Point result;
+  for (std::size_t j = 0; j < result.size(); ++j) {
+    result[j] = from[j] + t * (to[j] - from[j]);
+  }
+  return result;
+}
+
+Vertex nelder_mead(CandidateEvaluator* evaluator, const Point& start,
+                   const TuningOptions& options) {
+  std::array<Vertex, 4> simplex;
+  for (std::size_t i = 0; i < simplex.size(); ++i) {
+    simplex[i].x = start;
+    if (i > 0) {
+      simplex[i].x[i - 1] += kSimplexStep;
+    }
+    simplex[i].cost = evaluator->cost(simplex[i].x);
+  }
+  unsigned used = static_cast<unsigned>(simplex.size());
+  auto by_cost = [](const Vertex& a, const Vertex& b) {
+    return a.cost < b.cost;
+  };
+
+  while (used < options.max_evaluations) {
+    std::stable_sort(simplex.begin(), simplex.end(), by_cost);
+    Vertex& best = simplex[0];
+    Vertex& worst = simplex[3];
+    if (worst.cost - best.cost <=
+        options.tolerance * (std::fabs(best.cost) + 1e-12)) {
+      break;
+    }
+
+    Point centroid = {0, 0, 0};
+    for (std::size_t i = 0; i < 3; ++i) {
+      for (std::size_t j = 0; j < centroid.size(); ++j) {
+        centroid[j] += simplex[i].x[j] / 3;
+      }
+    }
+
+    Vertex reflected = {blend(centroid, worst.x, -1.0), 0};
+    reflected.cost = evaluator->cost(reflected.x);
+    ++used;
+    if (reflected.cost < best.cost) {
+      Vertex expanded = {blend(centroid, worst.x, -2.0), 0};
+      expanded.cost = evaluator->cost(expanded.x);
+      ++used;
+      worst = expanded.cost < reflected.cost ? expanded : reflected;
+    } else if (reflected.cost < simplex[2].cost) {
+      worst = reflected;
+    } else {
+      const bool outside = reflected.cost < worst.cost;
+      Vertex contracted = {
+          blend(centroid, outside ? reflected.x : worst.x, 0.5), 0};
+      contracted.cost = evaluator->cost(contracted.x);
+      ++used;
+      if (contracted.cost < std::min(reflected.cost, worst.cost)) {
+        worst = contracted;
+      } else {
+        for (std::size_t i = 1; i < simplex.size(); ++i) {
+          simplex[i].x = blend(best.x, simplex[i].x, 0.5);
+          simplex[i].cost = evaluator->cost(simplex[i].x);
+          ++used;
+        }
+      }
+    }
+  }
+  return *std::min_element(simplex.begin(), simplex.end(), by_cost);
+}
+
+// Starting gain magnitudes for plants the relay cannot make oscillate, from
+// the plant's static gain and dominant time scale.
+GainSet fallback_gains(const PlantParams& plant, double dt,
+                       const TuningOptions& options) {
+  double time_scale = 10 * dt;
+  if (plant.type == PlantType::first_order) {
+    time_scale = std::max(time_scale, plant.time_constant);
+  } else if (plant.type == PlantType::second_order) {
+    time_scale = std::max(time_scale, 1 / plant.natural_frequency);
+  }
+  time_scale = std::max(time_scale, plant.dead_time);
+  double kP = plant.gain != 0 ? 0.5 / plant.gain : 1.0;
+  GainSet gains = {kP, kP / time_scale, 0.1 * kP * time_scale,
+                   options.max_value, options.min_value, dt};
+  return gains;
+}
+
+}  // namespace
+
+RelayResult relay_test(const PlantParams& plant, double dt,
+                       const RelayOptions& options) {
+  if (options.amplitude <= 0 || options.hysteresis < 0 ||
+      options.cycles == 0) {
+    throw std::invalid_argument(
+        "amplitude and cycles should be greater than 0.");
+  }
+  DiscretePlant model(plant, dt);
+  RelayResult result = {0, 0, false};
+
+  // The first cycle is a transient; the next `cycles` are measured.
+  const std::size_t needed = options.cycles + 2;
+  std::vector<std::size_t> rising;
+  rising.reserve(needed);
+  double u = options.amplitude;
+  double high = -kInfinity;
+  double low = kInfinity;
+  for (std::size_t k = 0; k < options.max_steps; ++k) {
+    const double y = model.output();
+    const double error = -y;
+    if (u < 0 && error > options.hysteresis) {
+      u = options.amplitude;
+      rising.push_back(k);
+      if (rising.size() == needed) {
+        break;
+      }
+    } else if (u > 0 && error < -options.hysteresis) {
+      u = -options.amplitude;
+    }
+    if (rising.size() >= 2) {
+      high = std::max(high, y);
+      low = std::min(low, y);
+    }
+    model.step(u);
+  }
+  if (rising.size() < needed) {
+    return result;
+  }
+
+  const double a = (high - low) / 2;
+  if (!(a > options.hysteresis)) {
+    return result;
+  }
+  result.ultimate_gain =
+      4 * options.amplitude /
+      (kPi * std::sqrt(a * a - options.hysteresis * options.hysteresis));
+  result.ultimate_period =
+      static_cast<double>(rising.back() - rising[1]) * dt / options.cycles;
+  result.oscillated = true;
+  return result;
+}
+
+GainSet ziegler_nichols_gains(double ultimate_gain, double ultimate_period,
+                              double max_value, double min_value, double dt) {
+  if (ultimate_gain <= 0 || ultimate_period <= 0) {
+    throw std::invalid_argument(
+        "ultimate gain and period should be greater than 0.");
+  }
+  GainSet gains = {0.6 * ultimate_gain,
+                   1.2 * ultimate_gain / ultimate_period,
+                   0.075 * ultimate_gain * ultimate_period,
+                   max_value, min_value, dt};
+  return gains;
+}
+
+PlantParams fit_first_order_plant(const std::vector<TraceSample>& step_test) {
+  if (step_test.size() < 3) {
+    throw std::invalid_argument("step test should have at least 3 samples.");
+  }
+  const double u0 = step_test.front().setpoint;
+  std::size_t step = 0;
+  while (step < step_test.size() && step_test[step].setpoint == u0) {
+    ++step;
+  }
+  const double du = step_test.back().setpoint - u0;
+  if (step == 0 || step == step_test.size() || du == 0) {
+    throw std::invalid_argument("step test has no input step.");
+  }
+
+  double y0 = 0;
+  for (std::size_t i = 0; i < step; ++i) {
+    y0 += step_test[i].measured;
+  }
+  y0 /= static_cast<double>(step);
+  const double dy = step_test.back().measured - y0;
+  if (dy == 0) {
+    throw std::invalid_argument("step test has no output response.");
+  }
+
+  // First time the normalized response reaches fraction, interpolated.
+  auto crossing = [&](double fraction) {
+    double prev_t = step_test[step].timestamp;
+    double prev_r = 0;
+    for (std::size_t i = step; i < step_test.size(); ++i) {
+      const double t = step_test[i].timestamp;
+      const double r = (step_test[i].measured - y0) / dy;
+      if (r >= fraction) {
+        return r == prev_r
+                   ? t
+                   : prev_t + (fraction - prev_r) / (r - prev_r) * (t - prev_t);
+      }
+      prev_t = t;
+      prev_r = r;
+    }
+    return step_test.back().timestamp;
+  };
+  const double t28 = crossing(0.283);
+  const double t63 = crossing(0.632);
+  const double time_constant = 1.5 * (t63 - t28);
+  if (time_constant <= 0) {
+    throw std::invalid_argument("step test response is too fast to fit.");
+  }
+  const double dead_time =
+      std::max(0.0, t63 - time_constant - step_test[step].timestamp);
+  return first_order_plant(dy / du, time_constant, dead_time);
+}
+
+TuningResult tune_gains(const PlantParams& plant, double dt,
+                        const TuningOptions& options) {
+  if (options.starts == 0 || options.max_evaluations == 0) {
+    throw std::invalid_argument(
+        "starts and max_evaluations should be greater than 0.");
+  }
+  // Validates dt and the plant before any thread is started.
+  discretize(plant, dt);
+
+  TuningResult result;
+  // The relay and Ziegler-Nichols work on magnitudes; the sign of the plant
+  // gain is applied to the gains afterwards.
+  const double direction = plant_direction(plant);
+  PlantParams magnitude = plant;
+  magnitude.gain = std::fabs(plant.gain);
+  RelayResult relay = relay_test(magnitude, dt, options.relay);
+  GainSet start_gains =
+      relay.oscillated
+          ? ziegler_nichols_gains(relay.ultimate_gain, relay.ultimate_period,
+                                  options.max_value, options.min_value, dt)
+          : fallback_gains(magnitude, dt, options);
+
+  const Point origin = {std::log(start_gains.kP), std::log(start_gains.kI),
+                        std::log(start_gains.kD)};
+  result.initial_gains = start_gains;
+  result.initial_gains.kP *= direction;
+  result.initial_gains.kI *= direction;
+  result.initial_gains.kD *= direction;
+  std::vector<Vertex> bests(options.starts);
+  std::vector<uint64_t> evaluations(options.starts, 0);
+  std::vector<uint64_t> rejected(options.starts, 0);
+  parallel_for(options.starts, options.threads, [&](std::size_t s) {
+    Point start = origin;
+    if (s > 0) {
+      std::mt19937 rng(static_cast<std::mt19937::result_type>(s));
+      std::normal_distribution<double> spread(0.0, kStartSpread);
+      for (double& coordinate : start) {
+        coordinate += spread(rng);
+      }
+    }
+    CandidateEvaluator evaluator(plant, dt, options);
+    bests[s] = nelder_mead(&evaluator, start, options);
+    evaluations[s] = evaluator.get_evaluations();
+    rejected[s] = evaluator.get_rejected();
+  });
+
+  std::size_t winner = 0;
+  result.evaluations = 0;
+  result.rejected = 0;
+  for (std::size_t s = 0; s < bests.size(); ++s) {
+    if (bests[s].cost < bests[winner].cost) {
+      winner = s;
+    }
+    result.evaluations += evaluations[s];
+    result.rejected += rejected[s];
+  }
+
+  const Point& x = bests[winner].x;
+  GainSet gains = {direction * std::exp(x[0]), direction * std::exp(x[1]),
+                   direction * std::exp(x[2]), options.max_value,
+                   options.min_value, dt};
+  result.gains = gains;
+  CandidateEvaluator evaluator(plant, dt, options);
+  result.cost = evaluator.cost(x, &result.metrics);
+  return result;
+}
+
+TuningResult tune_gains(const std::vector<TraceSample>& step_test, double dt,
+                        const TuningOptions& options) {
+  return tune_gains(fit_first_order_plant(step_test), dt, options);
+}
@@ -0,0 +1,289 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <control_executor.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+const int64_t kNanosPerSecond = 1000000000;
+// Upper bound on one sleep so stop() is noticed promptly.
+const int64_t kMaxSleepNs = 10000000;
+
+int64_t monotonic_ns() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * kNanosPerSecond + ts.tv_nsec;
+}
+
+void sleep_until_ns(int64_t deadline_ns) {
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(deadline_ns / kNanosPerSecond);
+  ts.tv_nsec = static_cast<long>(deadline_ns % kNanosPerSecond);  // NOLINT
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+         EINTR) {
+  }
+}
+
+void pin_to_cpu(std::thread* thread, int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  // Best effort: without the permission or the core the loop still runs.
+  pthread_setaffinity_np(thread->native_handle(), sizeof(set), &set);
+#else
+  (void)thread;
+  (void)cpu;
+#endif
+}
+
+}  // namespace
+
+/**
+ * @brief One registered loop. Whoever wins the busy flag runs the tick and
+ * owns the statistics until it releases the flag.
+ *
+ */
+struct ControlExecutor::Loop {
+  AbstractPIDController* controller;
+  SignalSource setpoint;
+  SignalSource measurement;
+  Actuator actuator;
+  int64_t period_ns;
+  unsigned owner;
+
+  std::atomic<int64_t> next_deadline_ns;
+  std::atomic<bool> busy;
+
+  std::atomic<uint64_t> ticks;
+  std::atomic<uint64_t> overruns;
+  std::atomic<uint64_t> missed_deadlines;
+  std::atomic<uint64_t> stolen;
+  std::atomic<int64_t> jitter_sum_ns;
+  std::atomic<int64_t> max_jitter_ns;
+};
+
+ControlExecutor::ControlExecutor(unsigned worker_count,
+                                 const std::vector<int>& cpus,
+                                 int64_t steal_after_ns)
+    :
+    worker_count(worker_count),
+    cpus(cpus),
+    steal_after_ns(steal_after_ns),
+    running(false) {
+  if (worker_count == 0) {
+    throw std::invalid_argument("worker_count should be greater than 0.");
+  }
+}
+
+ControlExecutor::~ControlExecutor() {
+  stop();
+}
+
+std::size_t ControlExecutor::add_loop(AbstractPIDController* controller,
+                                      SignalSource setpoint,
+                                      SignalSource measurement,
+                                      Actuator actuator) {
+  if (running.load()) {
+    throw std::logic_error("loops should be added before start().");
+  }
+  if (controller == nullptr || !setpoint || !measurement || !actuator) {
+    throw std::invalid_argument("controller and callbacks should be set.");
+  }
+  std::unique_ptr<Loop> loop(new Loop());
+  loop->controller = controller;
+  loop->setpoint = std::move(setpoint);
+  loop->measurement = std::move(measurement);
+  loop->actuator = std::move(actuator);
+  loop->period_ns = std::max<int64_t>(
+      1, static_cast<int64_t>(controller->get_dt() * kNanosPerSecond));
+  loop->owner = 0;
+  loop->next_deadline_ns.store(0);
+  loop->busy.store(false);
+  loop->ticks.store(0);
+  loop->overruns.store(0);
+  loop->missed_deadlines.store(0);
+  loop->stolen.store(0);
+  loop->jitter_sum_ns.store(0);
+  loop->max_jitter_ns.store(0);
+  loops.push_back(std::move(loop));
+  return loops.size() - 1;
+}
+
+void ControlExecutor::start() {
+  if (running.exchange(true)) {
+    return;
+  }
+
+  // Greedy balancing: fastest loops first, each to the least loaded worker.
+  std::vector<Loop*> by_rate;
+  for (const std::unique_ptr<Loop>& loop : loops) {
+    by_rate.push_back(loop.get());
+  }
+  std::sort(by_rate.begin(), by_rate.end(), [](Loop* a, Loop* b) {
+    return a->period_ns < b->period_ns;
+  });
+  assignments.assign(worker_count, std::vector<Loop*>());
+  std::vector<double> load(worker_count, 0.0);
+  const int64_t start_ns = monotonic_ns();
+  for (Loop* loop : by_rate) {
+    unsigned target = static_cast<unsigned>(
+        std::min_element(load.begin(), load.end()) - load.begin());
+    load[target] += 1.0 / static_cast<double>(loop->period_ns);
+    loop->owner = target;
+    loop->next_deadline_ns.store(start_ns + loop->period_ns);
+    assignments[target].push_back(loop);
+  }
+
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned w = 0; w < worker_count; ++w) {
+    workers.emplace_back(&ControlExecutor::run_worker, this, w);
+    int cpu = cpus.empty() ? static_cast<int>(w % cores)
+                           : cpus[w % cpus.size()];
+    pin_to_cpu(&workers.back(), cpu);
+  }
+}
+
+void ControlExecutor::stop() {
+  running.store(false);
+  for (std::thread& worker : workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers.clear();
+}
+
+LoopStats ControlExecutor::get_stats(std::size_t index) const {
+  if (index >= loops.size()) {
+    throw std::out_of_range("loop index out of range.");
+  }
+  const Loop& loop = *loops[index];
+  LoopStats stats;
+  stats.ticks = loop.ticks.load(std::memory_order_relaxed);
+  stats.overruns = loop.overruns.load(std::memory_order_relaxed);
+  stats.missed_deadlines =
+      loop.missed_deadlines.load(std::memory_order_relaxed);
+  stats.stolen = loop.stolen.load(std::memory_order_relaxed);
+  stats.mean_jitter_ns =
+      stats.ticks == 0
+          ? 0.0
+          : static_cast<double>(
+                loop.jitter_sum_ns.load(std::memory_order_relaxed)) /
+                static_cast<double>(stats.ticks);
+  stats.max_jitter_ns = static_cast<double>(
+      loop.max_jitter_ns.load(std::memory_order_relaxed));
+  return stats;
+}
+
+std::size_t ControlExecutor::get_loop_count() const {
+  return loops.size();
+}
+
+unsigned ControlExecutor::get_worker_count() const {
+  return worker_count;
+}
+
+void ControlExecutor::run_worker(unsigned worker) {
+  const std::vector<Loop*>& own = assignments[worker];
+  while (running.load(std::memory_order_relaxed)) {
+    int64_t now = monotonic_ns();
+    int64_t wake = now + kMaxSleepNs;
+
+    for (Loop* loop : own) {
+      if (loop->next_deadline_ns.load(std::memory_order_acquire) <= now) {
+        run_tick(loop, worker, now);
+        now = monotonic_ns();
+      }
+      wake = std::min(wake,
+                      loop->next_deadline_ns.load(std::memory_order_acquire));
+    }
+
+    // Steal loops another worker has left overdue.
+    for (unsigned other = 0; other < worker_count; ++other) {
+      if (other == worker) {
+        continue;
+      }
+      for (Loop* loop : assignments[other]) {
+        if (loop->next_deadline_ns.load(std::memory_order_acquire) +
+                steal_after_ns <= now) {
+          if (run_tick(loop, worker, now)) {
+            now = monotonic_ns();
+          }
+        }
+      }
+    }
+
+    if (wake > monotonic_ns()) {
+      sleep_until_ns(wake);
+    }
+  }
+}
+
+bool ControlExecutor::run_tick(Loop* loop, unsigned worker, int64_t now_ns) {
+  bool expected = false;
+  if (!loop->busy.compare_exchange_strong(expected, true,
+                                          std::memory_order_acquire)) {
+    return false;
+  }
+  const int64_t deadline =
+      loop->next_deadline_ns.load(std::memory_order_relaxed);
+  if (deadline > now_ns) {
+    // Another worker ticked it in the meantime.
+    loop->busy.store(false, std::memory_order_release);
+    return false;
+  }
+
+  const int64_t begin = monotonic_ns();
+  double output = loop->controller->compute(loop->setpoint(),
+                                            loop->measurement());
+  loop->actuator(output);
+  const int64_t end = monotonic_ns();
+
+  const int64_t jitter = begin - deadline;
+  loop->ticks.store(loop->ticks.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+  loop->jitter_sum_ns.store(
+      loop->jitter_sum_ns.load(std::memory_order_relaxed) + jitter,
+      std::memory_order_relaxed);
+  if (jitter > loop->max_jitter_ns.load(std::memory_order_relaxed)) {
+    loop->max_jitter_ns.store(jitter, std::memory_order_relaxed);
+  }
+  if (worker != loop->owner) {
+    loop->stolen.store(loop->stolen.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+  }
+
+  int64_t next = deadline + loop->period_ns;
+  if (next <= end) {
+    loop->overruns.store(loop->overruns.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+    // Skip the deadlines that have already passed instead of bursting.
+    int64_t skipped = (end - next) / loop->period_ns + 1;
+    next += skipped * loop->period_ns;
+    loop->missed_deadlines.store(
+        loop->missed_deadlines.load(std::memory_order_relaxed) +
+            static_cast<uint64_t>(skipped),
+        std::memory_order_relaxed);
+  }
+  loop->next_deadline_ns.store(next, std::memory_order_relaxed);
+  loop->busy.store(false, std::memory_order_release);
+  return true;
+}
@@ -0,0 +1,269 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <controller_graph.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+ControllerGraph::ControllerGraph()
+    :
+    compiled(false) {
+}
+
+ControllerGraph::NodeId ControllerGraph::add_node(Kind kind,
+                                                  unsigned decimation) {
+  if (decimation == 0) {
+    throw std::invalid_argument("decimation should be greater than 0.");
+  }
+  Node node = {};
+  node.kind = kind;
+  node.decimation = decimation;
+  declared.push_back(node);
+  compiled = false;
+  return declared.size() - 1;
+}
+
+ControllerGraph::NodeId ControllerGraph::add_input() {
+  return add_node(Kind::input, 1);
+}
+
+ControllerGraph::NodeId ControllerGraph::add_pid(const GainSet& gains,
+                                                 unsigned decimation) {
+  if (!(gains.dt > 0)) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+  NodeId id = add_node(Kind::pid, decimation);
+  double* param = declared[id].param;
+  param[0] = gains.kP;
+  param[1] = gains.kI;
+  param[2] = gains.kD / gains.dt;
+  param[3] = gains.max_value;
+  param[4] = gains.min_value;
+  param[5] = gains.dt;
+  return id;
+}
+
+ControllerGraph::NodeId ControllerGraph::add_gain(double gain,
+                                                  unsigned decimation) {
+  NodeId id = add_node(Kind::gain, decimation);
+  declared[id].param[0] = gain;
+  return id;
+}
+
+ControllerGraph::NodeId ControllerGraph::add_sum(unsigned decimation) {
+  return add_node(Kind::sum, decimation);
+}
+
+ControllerGraph::NodeId ControllerGraph::add_feedforward(double gain,
+                                                         double rate_gain,
+                                                         double dt,
+                                                         unsigned decimation) {
+  if (!(dt > 0)) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+  NodeId id = add_node(Kind::feedforward, decimation);
+  declared[id].param[0] = gain;
+  declared[id].param[1] = rate_gain / dt;
+  return id;
+}
+
+ControllerGraph::NodeId ControllerGraph::add_limiter(double min_value,
+                                                     double max_value,
+                                                     unsigned decimation) {
+  if (min_value > max_value) {
+    throw std::invalid_argument("min_value should not exceed max_value.");
+  }
+  NodeId id = add_node(Kind::limiter, decimation);
+  declared[id].param[0] = min_value;
+  declared[id].param[1] = max_value;
+  return id;
+}
+
+void ControllerGraph::check_node(NodeId node) const {
+  if (node >= declared.size()) {
+    throw std::out_of_range("node id out of range.");
+  }
+}
+
+void ControllerGraph::connect(NodeId from, NodeId to, Port port,
+                              double weight) {
+  check_node(from);
+  check_node(to);
+  Kind kind = declared[to].kind;
+  if (kind == Kind::input) {
+    throw std::invalid_argument("input nodes cannot have incoming edges.");
+  }
+  if ((kind == Kind::pid) != (port != Port::input)) {
+    throw std::invalid_argument(
+        "pid nodes take setpoint and measured ports, other nodes input.");
+  }
+  Link link = {from, to, port, weight};
+  links.push_back(link);
+  compiled = false;
+}
+
+void ControllerGraph::compile() {
+  const std::size_t count = declared.size();
+
+  // Kahn's algorithm; ready nodes are taken in id order so the layout is
+  // deterministic.
+  std::vector<std::size_t> pending(count, 0);
+  std::vector<std::vector<NodeId> > successors(count);
+  for (const Link& link : links) {
+    ++pending[link.to];
+    successors[link.from].push_back(link.to);
+  }
+  std::vector<NodeId> order;
+  order.reserve(count);
+  for (NodeId id = 0; id < count; ++id) {
+    if (pending[id] == 0) {
+      order.push_back(id);
+    }
+  }
+  for (std::size_t next = 0; next < order.size(); ++next) {
+    for (NodeId successor : successors[order[next]]) {
+      if (--pending[successor] == 0) {
+        order.push_back(successor);
+      }
+    }
+  }
+  if (order.size() != count) {
+    throw std::invalid_argument("controller graph has a cycle.");
+  }
+
+  slot_of.assign(count, 0);
+  for (std::size_t slot = 0; slot < count; ++slot) {
+    slot_of[order[slot]] = static_cast<uint32_t>(slot);
+  }
+
+  // Group the edges by destination slot.
+  std::vector<Link> sorted(links);
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [this](const Link& a, const Link& b) {
+    return slot_of[a.to] < slot_of[b.to];
+  });
+  nodes.clear();
+  nodes.reserve(count);
+  edges.clear();
+  edges.reserve(sorted.size());
+  std::size_t link = 0;
+  for (std::size_t slot = 0; slot < count; ++slot) {
+    Node node = declared[order[slot]];
+    node.edge_begin = static_cast<uint32_t>(edges.size());
+    while (link < sorted.size() && slot_of[sorted[link].to] == slot) {
+      Edge edge = {slot_of[sorted[link].from],
+                   sorted[link].port == Port::measured ? 1u : 0u,
+                   sorted[link].weight};
+      edges.push_back(edge);
+      ++link;
+    }
+    node.edge_end = static_cast<uint32_t>(edges.size());
+    nodes.push_back(node);
+  }
+  outputs.assign(count, 0.0);
+  compiled = true;
+  reset();
+}
+
+bool ControllerGraph::is_compiled() const {
+  return compiled;
+}
+
+void ControllerGraph::set_input(NodeId input, double value) {
+  check_node(input);
+  if (declared[input].kind != Kind::input) {
+    throw std::invalid_argument("node is not an input.");
+  }
+  if (!compiled) {
+    throw std::logic_error("graph should be compiled first.");
+  }
+  outputs[slot_of[input]] = value;
+}
+
+void ControllerGraph::tick() {
+  if (!compiled) {
+    throw std::logic_error("graph should be compiled first.");
+  }
+  const std::size_t count = nodes.size();
+  for (std::size_t slot = 0; slot < count; ++slot) {
+    Node& node = nodes[slot];
+    if (node.kind == Kind::input || --node.countdown != 0) {
+      continue;
+    }
+    node.countdown = node.decimation;
+
+    double in[2] = {0.0, 0.0};
+    for (uint32_t e = node.edge_begin; e < node.edge_end; ++e) {
+      in[edges[e].port] += edges[e].weight * outputs[edges[e].source];
+    }
+
+    double output;
+    switch (node.kind) {
+      case Kind::pid: {
+        // Same operations, in the same order, as PIDController::compute().
+        double error = in[0] - in[1];
+        double proportional_out = node.param[0] * error;
+        node.state[0] += error * node.param[5];
+        double integral_out = node.param[1] * node.state[0];
+        double derivative_out = node.param[2] * (error - node.state[1]);
+        output = proportional_out + integral_out + derivative_out;
+        if (output > node.param[3]) {
+          output = node.param[3];
+        } else if (output < node.param[4]) {
+          output = node.param[4];
+        }
+        node.state[1] = error;
+        break;
+      }
+      case Kind::gain:
+        output = node.param[0] * in[0];
+        break;
+      case Kind::feedforward:
+        output = node.param[0] * in[0] +
+                 node.param[1] * (in[0] - node.state[0]);
+        node.state[0] = in[0];
+        break;
+      case Kind::limiter:
+        output = std::min(std::max(in[0], node.param[0]), node.param[1]);
+        break;
+      default:  // Kind::sum
+        output = in[0];
+        break;
+    }
+    outputs[slot] = output;
+  }
+}
+
+double ControllerGraph::get_output(NodeId node) const {
+  check_node(node);
+  if (!compiled) {
+    throw std::logic_error("graph should be compiled first.");
+  }
+  return outputs[slot_of[node]];
+}
+
+void ControllerGraph::reset() {
+  for (std::size_t slot = 0; slot < nodes.size(); ++slot) {
+    Node& node = nodes[slot];
+    // Due on the next tick.
+    node.countdown = 1;
+    node.state[0] = 0;
+    node.state[1] = 0;
+    if (node.kind != Kind::input) {
+      outputs[slot] = 0;
+    }
+  }
+}
+
+std::size_t ControllerGraph::get_node_count() const {
+  return declared.size();
+}
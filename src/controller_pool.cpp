@@ -0,0 +1,159 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <controller_pool.hpp>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+const std::size_t kCacheLine = 64;
+const std::size_t kSlotSize =
+    (sizeof(PIDController) + kCacheLine - 1) / kCacheLine * kCacheLine;
+const uint32_t kAllocated = UINT32_MAX;
+const uint32_t kEnd = UINT32_MAX - 1;
+
+std::size_t round_up(std::size_t value, std::size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+}  // namespace
+
+ControllerPool::ControllerPool() noexcept
+    :
+    arena(nullptr),
+    arena_bytes(0),
+    next_free(nullptr),
+    slot_count(0),
+    live(0),
+    free_head(kEnd),
+    locked(false) {
+}
+
+ControllerPool::~ControllerPool() {
+  release();
+}
+
+PIDStatus ControllerPool::reserve(std::size_t capacity,
+                                  bool lock_memory) noexcept {
+  if (live > 0) {
+    return PIDStatus::in_use;
+  }
+  release();
+  if (capacity == 0 || capacity >= kEnd) {
+    return PIDStatus::invalid_argument;
+  }
+  const long page = sysconf(_SC_PAGESIZE);  // NOLINT
+  const std::size_t page_size = page > 0 ? static_cast<std::size_t>(page)
+                                         : 4096;
+  const std::size_t bytes = round_up(
+      capacity * kSlotSize + capacity * sizeof(uint32_t), page_size);
+  void* raw = nullptr;
+  if (posix_memalign(&raw, page_size, bytes) != 0) {
+    return PIDStatus::out_of_memory;
+  }
+  if (lock_memory && mlock(raw, bytes) != 0) {
+    std::free(raw);
+    return PIDStatus::lock_failed;
+  }
+  // Touch every page now so the first create() does not fault either.
+  std::memset(raw, 0, bytes);
+
+  arena = static_cast<unsigned char*>(raw);
+  arena_bytes = bytes;
+  next_free = reinterpret_cast<uint32_t*>(arena + capacity * kSlotSize);
+  slot_count = capacity;
+  locked = lock_memory;
+  for (std::size_t i = 0; i < capacity; ++i) {
+    next_free[i] = i + 1 < capacity ? static_cast<uint32_t>(i + 1) : kEnd;
+  }
+  free_head = 0;
+  return PIDStatus::ok;
+}
+
+PIDResult<PIDController*> ControllerPool::create(
+    const GainSet& gains) noexcept {
+  if (PIDController::check_gains(gains) != PIDStatus::ok) {
+    return {PIDStatus::invalid_dt, nullptr};
+  }
+  if (free_head == kEnd) {
+    return {PIDStatus::pool_exhausted, nullptr};
+  }
+  const uint32_t slot = free_head;
+  free_head = next_free[slot];
+  next_free[slot] = kAllocated;
+  ++live;
+  // check_gains() accepted gains.dt, so the constructor does not throw.
+  PIDController* controller = new (arena + slot * kSlotSize)
+      PIDController(gains.kP, gains.kI, gains.kD, gains.max_value,
+                    gains.min_value, gains.dt);
+  return {PIDStatus::ok, controller};
+}
+
+PIDStatus ControllerPool::destroy(PIDController* controller) noexcept {
+  const unsigned char* address =
+      reinterpret_cast<const unsigned char*>(controller);
+  if (arena == nullptr || address < arena ||
+      address >= arena + slot_count * kSlotSize ||
+      (address - arena) % kSlotSize != 0) {
+    return PIDStatus::invalid_argument;
+  }
+  const std::size_t slot = (address - arena) / kSlotSize;
+  if (next_free[slot] != kAllocated) {
+    return PIDStatus::invalid_argument;
+  }
+  controller->~PIDController();
+  next_free[slot] = free_head;
+  free_head = static_cast<uint32_t>(slot);
+  --live;
+  return PIDStatus::ok;
+}
+
+std::size_t ControllerPool::size() const noexcept {
+  return live;
+}
+
+std::size_t ControllerPool::capacity() const noexcept {
+  return slot_count;
+}
+
+bool ControllerPool::is_locked() const noexcept {
+  return locked;
+}
+
+void ControllerPool::release() noexcept {
+  if (arena == nullptr) {
+    return;
+  }
+  for (std::size_t slot = 0; slot < slot_count && live > 0; ++slot) {
+    if (next_free[slot] == kAllocated) {
+      reinterpret_cast<PIDController*>(arena + slot * kSlotSize)
+          ->~PIDController();
+      --live;
+    }
+  }
+  if (locked) {
+    munlock(arena, arena_bytes);
+  }
+  std::free(arena);
+  arena = nullptr;
+  arena_bytes = 0;
+  next_free = nullptr;
+  slot_count = 0;
+  live = 0;
+  free_head = kEnd;
+  locked = false;
+}
@@ -0,0 +1,214 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <discrete_pid.hpp>
+
+#include <stdexcept>
+
+DiscretePIDController::DiscretePIDController(double kP, double kI, double kD,
+                                             double max_value,
+                                             double min_value, double dt)
+    :
+    kP(kP),
+    kI(kI),
+    kD(kD),
+    max_value(max_value),
+    min_value(min_value),
+    dt(dt),
+    filter_time(0),
+    tracking_gain(1),
+    form(PIDForm::positional),
+    anti_windup(AntiWindupMode::none),
+    coefficients_valid(false),
+    kI_dt(0),
+    tracking_gain_dt(0),
+    filter_pole(0),
+    derivative_gain(0),
+    integral_term(0),
+    derivative_term(0),
+    prev_error(0),
+    prev_output(0) {
+  if (!(dt > 0)) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+}
+
+DiscretePIDController::~DiscretePIDController() {
+}
+
+double DiscretePIDController::compute(double setpoint_value,
+                                      double measured_value) {
+  if (!coefficients_valid) {
+    update_coefficients();
+  }
+
+  double error = setpoint_value - measured_value;
+  double proportional_out = kP * error;
+  double derivative_out = filter_pole * derivative_term +
+                          derivative_gain * (error - prev_error);
+
+  double unclamped;
+  if (form == PIDForm::velocity) {
+    unclamped = prev_output + kP * (error - prev_error) + kI_dt * error +
+                (derivative_out - derivative_term);
+  } else {
+    double integral = integral_term + kI_dt * error;
+    unclamped = proportional_out + integral + derivative_out;
+    if (anti_windup == AntiWindupMode::clamping &&
+        ((unclamped > max_value && error > 0) ||
+         (unclamped < min_value && error < 0))) {
+      // Integrating would push further into saturation.
+      integral = integral_term;
+      unclamped = proportional_out + integral + derivative_out;
+    }
+    integral_term = integral;
+  }
+
+  double output = unclamped;
+  if (output > max_value) {
+    output = max_value;
+  } else if (output < min_value) {
+    output = min_value;
+  }
+
+  if (form == PIDForm::velocity) {
+    // The integral implied by the clamped output.
+    integral_term = output - proportional_out - derivative_out;
+  } else if (anti_windup == AntiWindupMode::back_calculation) {
+    integral_term += tracking_gain_dt * (output - unclamped);
+  }
+
+  derivative_term = derivative_out;
+  prev_error = error;
+  prev_output = output;
+  return output;
+}
+
+void DiscretePIDController::update_coefficients() {
+  kI_dt = kI * dt;
+  tracking_gain_dt = tracking_gain * dt;
+  filter_pole = filter_time / (filter_time + dt);
+  derivative_gain = kD / (filter_time + dt);
+  coefficients_valid = true;
+}
+
+double DiscretePIDController::get_dt() const {
+  return dt;
+}
+
+void DiscretePIDController::set_dt(double dT) {
+  if (!(dT > 0)) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+  dt = dT;
+  coefficients_valid = false;
+}
+
+double DiscretePIDController::get_kD() const {
+  return kD;
+}
+
+void DiscretePIDController::set_kD(double kd) {
+  kD = kd;
+  coefficients_valid = false;
+}
+
+double DiscretePIDController::get_kI() const {
+  return kI;
+}
+
+void DiscretePIDController::set_kI(double ki) {
+  kI = ki;
+  coefficients_valid = false;
+}
+
+double DiscretePIDController::get_kP() const {
+  return kP;
+}
+
+void DiscretePIDController::set_kP(double kp) {
+  kP = kp;
+}
+
+double DiscretePIDController::get_max_value() const {
+  return max_value;
+}
+
+void DiscretePIDController::set_max_value(double maxValue) {
+  max_value = maxValue;
+}
+
+double DiscretePIDController::get_min_value() const {
+  return min_value;
+}
+
+void DiscretePIDController::set_min_value(double minValue) {
+  min_value = minValue;
+}
+
+double DiscretePIDController::get_prev_error() const {
+  return prev_error;
+}
+
+double DiscretePIDController::get_integral_sum() const {
+  return kI != 0 ? integral_term / kI : 0;
+}
+
+double DiscretePIDController::get_integral_term() const {
+  return integral_term;
+}
+
+double DiscretePIDController::get_derivative_filter() const {
+  return filter_time;
+}
+
+void DiscretePIDController::set_derivative_filter(double time_constant) {
+  if (time_constant < 0) {
+    throw std::invalid_argument("filter time constant should not be negative.");
+  }
+  filter_time = time_constant;
+  coefficients_valid = false;
+}
+
+PIDForm DiscretePIDController::get_form() const {
+  return form;
+}
+
+void DiscretePIDController::set_form(PIDForm pid_form) {
+  form = pid_form;
+}
+
+AntiWindupMode DiscretePIDController::get_anti_windup() const {
+  return anti_windup;
+}
+
+void DiscretePIDController::set_anti_windup(AntiWindupMode mode) {
+  anti_windup = mode;
+}
+
+double DiscretePIDController::get_tracking_gain() const {
+  return tracking_gain;
+}
+
+void DiscretePIDController::set_tracking_gain(double gain) {
+  if (gain < 0) {
+    throw std::invalid_argument("tracking gain should not be negative.");
+  }
+  tracking_gain = gain;
+  coefficients_valid = false;
+}
+
+void DiscretePIDController::reset() {
+  integral_term = 0;
+  derivative_term = 0;
+  prev_error = 0;
+  prev_output = 0;
+}
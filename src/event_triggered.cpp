@@ -0,0 +1,154 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <event_triggered.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+EventTriggeredController::EventTriggeredController(const GainSet& gains,
+                                                   double threshold,
+                                                   double max_interval)
+    :
+    controller(gains.kP, gains.kI, gains.kD, gains.max_value,
+               gains.min_value, gains.dt),
+    threshold(0),
+    max_interval(1),
+    started(false),
+    last_timestamp(0),
+    last_error(0),
+    sample_timestamp(0),
+    sample_error(0),
+    held_integral(0),
+    output(0),
+    computes(0),
+    skips(0) {
+  set_threshold(threshold);
+  set_max_interval(max_interval);
+}
+
+bool EventTriggeredController::update(double timestamp,
+                                      double setpoint_value,
+                                      double measured_value) {
+  const double error = setpoint_value - measured_value;
+  double step = controller.get_dt();
+  if (started) {
+    step = timestamp - sample_timestamp;
+    // Also rejects NaN timestamps.
+    if (!(step > 0)) {
+      ++skips;
+      return false;
+    }
+    if (std::fabs(error - last_error) <= threshold &&
+        timestamp - last_timestamp < max_interval) {
+      // Integrate the held sample like a per-sample controller would.
+      held_integral += error * step;
+      sample_timestamp = timestamp;
+      sample_error = error;
+      ++skips;
+      return false;
+    }
+    if (sample_timestamp != last_timestamp) {
+      controller.set_state(controller.get_integral_sum() + held_integral,
+                           sample_error);
+    }
+  }
+  output = controller.compute_with_dt(setpoint_value, measured_value, step);
+  started = true;
+  last_timestamp = timestamp;
+  last_error = error;
+  sample_timestamp = timestamp;
+  sample_error = error;
+  held_integral = 0;
+  ++computes;
+  return true;
+}
+
+double EventTriggeredController::get_output() const {
+  return output;
+}
+
+PIDController& EventTriggeredController::get_controller() {
+  return controller;
+}
+
+double EventTriggeredController::get_threshold() const {
+  return threshold;
+}
+
+void EventTriggeredController::set_threshold(double value) {
+  if (!(value >= 0)) {
+    throw std::invalid_argument("threshold should not be negative.");
+  }
+  threshold = value;
+}
+
+double EventTriggeredController::get_max_interval() const {
+  return max_interval;
+}
+
+void EventTriggeredController::set_max_interval(double value) {
+  if (!(value > 0)) {
+    throw std::invalid_argument("max_interval should be greater than 0.");
+  }
+  max_interval = value;
+}
+
+uint64_t EventTriggeredController::get_compute_count() const {
+  return computes;
+}
+
+uint64_t EventTriggeredController::get_skip_count() const {
+  return skips;
+}
+
+void EventTriggeredController::reset() {
+  controller.reset();
+  started = false;
+  last_timestamp = 0;
+  last_error = 0;
+  sample_timestamp = 0;
+  sample_error = 0;
+  held_integral = 0;
+  output = 0;
+}
+
+std::size_t EventTriggeredBatch::add(const GainSet& gains, double threshold,
+                                     double max_interval) {
+  controllers.emplace_back(gains, threshold, max_interval);
+  return controllers.size() - 1;
+}
+
+std::size_t EventTriggeredBatch::size() const {
+  return controllers.size();
+}
+
+std::size_t EventTriggeredBatch::update(double timestamp,
+                                        const double* setpoints,
+                                        const double* measured,
+                                        double* outputs,
+                                        std::size_t* changed) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < controllers.size(); ++i) {
+    if (controllers[i].update(timestamp, setpoints[i], measured[i])) {
+      outputs[i] = controllers[i].get_output();
+      changed[count++] = i;
+    }
+  }
+  return count;
+}
+
+EventTriggeredController& EventTriggeredBatch::get(std::size_t index) {
+  if (index >= controllers.size()) {
+    throw std::out_of_range("controller index out of range.");
+  }
+  return controllers[index];
+}
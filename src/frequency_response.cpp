@@ -0,0 +1,297 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <frequency_response.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <parallel.hpp>
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+const double kPi = 3.14159265358979323846;
+const double kDegrees = 180.0 / kPi;
+const double kHalfPowerDb = -3.0102999566398120;  // 10 log10(1 / 2)
+
+// Configurations analyzed together by one thread, sharing its buffers
+const std::size_t kChunkSize = 64;
+
+/**
+ * @brief Gain and unwrapped phase of the open and closed loop from L
+ *
+ */
+void bode(const double* real, const double* imag, std::size_t points,
+          double* open_gain, double* open_phase, double* closed_gain,
+          double* closed_phase) {
+  for (std::size_t k = 0; k < points; ++k) {
+    const double re = real[k];
+    const double im = imag[k];
+    const double magnitude = re * re + im * im;
+    // T = L / (1 + L), so |T|^2 = |L|^2 / |1 + L|^2
+    const double loop = (1.0 + re) * (1.0 + re) + im * im;
+    open_gain[k] = 10.0 * std::log10(magnitude);
+    closed_gain[k] = 10.0 * std::log10(magnitude / loop);
+  }
+  double previous_open = 0;
+  double previous_closed = 0;
+  double offset_open = 0;
+  double offset_closed = 0;
+  for (std::size_t k = 0; k < points; ++k) {
+    const double re = real[k];
+    const double im = imag[k];
+    const double open = std::atan2(im, re);
+    // arg T = arg(L conj(1 + L)) = arg(re (1 + re) + im^2 + j im)
+    const double closed = std::atan2(im, re * (1.0 + re) + im * im);
+    if (k > 0) {
+      offset_open -= 2 * kPi * std::round((open - previous_open) / (2 * kPi));
+      offset_closed -=
+          2 * kPi * std::round((closed - previous_closed) / (2 * kPi));
+    }
+    previous_open = open;
+    previous_closed = closed;
+    open_phase[k] = (open + offset_open) * kDegrees;
+    if (closed_phase != nullptr) {
+      closed_phase[k] = (closed + offset_closed) * kDegrees;
+    }
+  }
+}
+
+/**
+ * @brief Margins from the Bode curves. The grid is logarithmic, so a
+ * crossing is interpolated linearly in the point index.
+ *
+ */
+StabilityMargins margins(const std::vector<double>& theta, double dt,
+                         const double* open_gain, const double* open_phase,
+                         const double* closed_gain) {
+  StabilityMargins result = {kInfinity, kInfinity, kInfinity, kInfinity,
+                             kInfinity};
+  const std::size_t points = theta.size();
+  auto frequency = [&](std::size_t k, double t) {
+    return theta[k] * std::pow(theta[k + 1] / theta[k], t) / dt;
+  };
+  const double band = closed_gain[0] + kHalfPowerDb;
+  bool below_band = false;
+  for (std::size_t k = 0; k + 1 < points; ++k) {
+    const double g0 = open_gain[k];
+    const double g1 = open_gain[k + 1];
+    if ((g0 >= 0) != (g1 >= 0)) {
+      const double t = g0 / (g0 - g1);
+      const double phase = open_phase[k] + t * (open_phase[k + 1] -
+                                                open_phase[k]);
+      // Distance from -180 deg, wrapped to (-180, 180]
+      const double margin = phase + 180.0 - 360.0 * std::ceil(phase / 360.0);
+      if (result.phase_margin == kInfinity || margin < result.phase_margin) {
+        result.phase_margin = margin;
+        result.gain_crossover = frequency(k, t);
+      }
+    }
+
+    const double q0 = (open_phase[k] + 180.0) / 360.0;
+    const double q1 = (open_phase[k + 1] + 180.0) / 360.0;
+    if (std::floor(q0) != std::floor(q1)) {
+      const double turn = std::max(std::floor(q0), std::floor(q1));
+      const double t = (turn - q0) / (q1 - q0);
+      const double margin = -(g0 + t * (g1 - g0));
+      if (result.gain_margin == kInfinity || margin < result.gain_margin) {
+        result.gain_margin = margin;
+        result.phase_crossover = frequency(k, t);
+      }
+    }
+
+    const double c0 = closed_gain[k];
+    const double c1 = closed_gain[k + 1];
+    if (!below_band && c0 >= band && c1 < band) {
+      below_band = true;
+      result.bandwidth = frequency(k, (c0 - band) / (c0 - c1));
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Open-loop response without the dead time, L = C P, over the grid.
+ * Real arithmetic only, on arrays that do not alias, so the loop
+ * vectorizes; src/CMakeLists.txt builds this file at -O3.
+ *
+ */
+void open_loop_kernel(const double* __restrict c, const double* __restrict s,
+                      const double* __restrict v, std::size_t points,
+                      const double* controller, const double* plant,
+                      double* __restrict real, double* __restrict imag) {
+  const double proportional = controller[0];
+  const double integral = controller[1];
+  const double derivative = controller[2];
+  const double m11 = plant[0];
+  const double m12 = plant[1];
+  const double m22 = plant[2];
+  const double n1 = plant[3];
+  const double n2 = plant[4];
+  const double coupling = plant[5];
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC ivdep
+#endif
+  for (std::size_t k = 0; k < points; ++k) {
+    // C = kP + kI dt / (1 - z^-1) + kD / dt (1 - z^-1), z = c + j s
+    const double dr = v[k];
+    const double di = s[k];
+    const double dn = dr * dr + di * di;
+    const double cr = proportional + integral * dr / dn + derivative * dr;
+    const double ci = -integral * di / dn + derivative * di;
+    // P = ((z - a22) b1 + a12 b2) / ((z - a11) (z - a22) - a12 a21)
+    const double nr = (c[k] - m22) * n1 + m12 * n2;
+    const double ni = s[k] * n1;
+    const double er = (c[k] - m11) * (c[k] - m22) - s[k] * s[k] - coupling;
+    const double ei = s[k] * ((c[k] - m11) + (c[k] - m22));
+    const double en = er * er + ei * ei;
+    const double pr = (nr * er + ni * ei) / en;
+    const double pi = (ni * er - nr * ei) / en;
+    real[k] = cr * pr - ci * pi;
+    imag[k] = cr * pi + ci * pr;
+  }
+}
+
+}  // namespace
+
+FrequencyAnalyzer::FrequencyAnalyzer(const FrequencyOptions& options) {
+  if (options.points < 2 || !(options.decades > 0)) {
+    throw std::invalid_argument(
+        "points should be at least 2 and decades greater than 0.");
+  }
+  theta.resize(options.points);
+  cosine.resize(options.points);
+  sine.resize(options.points);
+  versine.resize(options.points);
+  const double last = static_cast<double>(options.points - 1);
+  for (std::size_t k = 0; k < options.points; ++k) {
+    const double position = static_cast<double>(k) / last;
+    theta[k] = kPi * std::pow(10.0, -options.decades * (1.0 - position));
+    cosine[k] = std::cos(theta[k]);
+    sine[k] = std::sin(theta[k]);
+    // 1 - cos, without the cancellation at low frequencies
+    versine[k] = 2.0 * std::sin(theta[k] / 2) * std::sin(theta[k] / 2);
+  }
+}
+
+std::size_t FrequencyAnalyzer::add(const AbstractPIDController& controller,
+                                   const PlantParams& plant) {
+  GainSet gains = {controller.get_kP(), controller.get_kI(),
+                   controller.get_kD(), controller.get_max_value(),
+                   controller.get_min_value(), controller.get_dt()};
+  return add(gains, plant);
+}
+
+std::size_t FrequencyAnalyzer::add(const GainSet& gains,
+                                   const PlantParams& plant) {
+  DiscretePlantModel model = discretize(plant, gains.dt);
+  kP.push_back(gains.kP);
+  kI.push_back(gains.kI);
+  kD.push_back(gains.kD);
+  dt.push_back(gains.dt);
+  a11.push_back(model.a11);
+  a12.push_back(model.a12);
+  a21.push_back(model.a21);
+  a22.push_back(model.a22);
+  b1.push_back(model.b1);
+  b2.push_back(model.b2);
+  delay_samples.push_back(model.delay_samples);
+  if (model.delay_samples > 0 &&
+      delay_rows.find(model.delay_samples) == delay_rows.end()) {
+    // z^-delay over the grid, once per distinct delay
+    const std::size_t points = theta.size();
+    const double delay = static_cast<double>(model.delay_samples);
+    const std::size_t row = delay_rows.size();
+    delay_rows[model.delay_samples] = row;
+    for (std::size_t k = 0; k < points; ++k) {
+      delay_real.push_back(std::cos(delay * theta[k]));
+      delay_imag.push_back(-std::sin(delay * theta[k]));
+    }
+  }
+  return kP.size() - 1;
+}
+
+std::size_t FrequencyAnalyzer::size() const {
+  return kP.size();
+}
+
+void FrequencyAnalyzer::open_loop(std::size_t index, double* real,
+                                  double* imag) const {
+  const std::size_t points = theta.size();
+  const double controller[] = {kP[index], kI[index] * dt[index],
+                               kD[index] / dt[index]};
+  const double plant[] = {a11[index], a12[index], a22[index],
+                          b1[index], b2[index], a12[index] * a21[index]};
+  open_loop_kernel(cosine.data(), sine.data(), versine.data(), points,
+                   controller, plant, real, imag);
+
+  if (delay_samples[index] > 0) {
+    // times z^-delay, from the row shared by every configuration with this
+    // delay
+    const std::size_t row = delay_rows.find(delay_samples[index])->second;
+    const double* wr = delay_real.data() + row * points;
+    const double* wi = delay_imag.data() + row * points;
+    for (std::size_t k = 0; k < points; ++k) {
+      const double re = real[k];
+      real[k] = re * wr[k] - imag[k] * wi[k];
+      imag[k] = re * wi[k] + imag[k] * wr[k];
+    }
+  }
+}
+
+std::vector<StabilityMargins> FrequencyAnalyzer::analyze(
+    unsigned threads) const {
+  const std::size_t count = size();
+  const std::size_t points = theta.size();
+  std::vector<StabilityMargins> result(count);
+  const std::size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+  parallel_for(chunks, threads, [&](std::size_t chunk) {
+    std::vector<double> buffer(5 * points);
+    double* real = buffer.data();
+    double* imag = real + points;
+    double* open_gain = imag + points;
+    double* open_phase = open_gain + points;
+    double* closed_gain = open_phase + points;
+    const std::size_t end = std::min(count, (chunk + 1) * kChunkSize);
+    for (std::size_t i = chunk * kChunkSize; i < end; ++i) {
+      open_loop(i, real, imag);
+      bode(real, imag, points, open_gain, open_phase, closed_gain, nullptr);
+      result[i] = margins(theta, dt[i], open_gain, open_phase, closed_gain);
+    }
+  });
+  return result;
+}
+
+FrequencyResponse FrequencyAnalyzer::get_response(std::size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("configuration index out of range.");
+  }
+  const std::size_t points = theta.size();
+  FrequencyResponse response;
+  response.frequency.resize(points);
+  response.open_gain.resize(points);
+  response.open_phase.resize(points);
+  response.closed_gain.resize(points);
+  response.closed_phase.resize(points);
+  std::vector<double> real(points);
+  std::vector<double> imag(points);
+  open_loop(index, real.data(), imag.data());
+  bode(real.data(), imag.data(), points, response.open_gain.data(),
+       response.open_phase.data(), response.closed_gain.data(),
+       response.closed_phase.data());
+  for (std::size_t k = 0; k < points; ++k) {
+    response.frequency[k] = theta[k] / dt[index];
+  }
+  return response;
+}
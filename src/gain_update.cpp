@@ -0,0 +1,44 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gain_update.hpp>
+
+#include <stdexcept>
+
+GainUpdateChannel::GainUpdateChannel() {
+}
+
+void GainUpdateChannel::publish(const GainSet& gains, bool bumpless) {
+  if (!(gains.dt > 0)) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+  GainUpdate update;
+  update.gains = gains;
+  update.bumpless = bumpless;
+  latest.write(update);
+}
+
+bool GainUpdateChannel::poll(uint64_t* last_version,
+                             GainUpdate* update) const {
+  if (latest.get_version() == *last_version) {
+    return false;
+  }
+  uint64_t version = 0;
+  if (!latest.try_read(update, &version) || version == *last_version) {
+    return false;
+  }
+  *last_version = version;
+  return true;
+}
+
+uint64_t GainUpdateChannel::get_version() const {
+  return latest.get_version();
+}
@@ -0,0 +1,60 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <mapped_file.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+MappedFile::MappedFile(const std::string& path)
+    :
+    address(nullptr),
+    length(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("cannot open " + path);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("cannot stat " + path);
+  }
+  length = static_cast<std::size_t>(info.st_size);
+  if (length > 0) {
+    address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      address = nullptr;
+      close(fd);
+      throw std::runtime_error("cannot map " + path);
+    }
+    // Traces are read front to back once.
+    madvise(address, length, MADV_SEQUENTIAL);
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (address != nullptr) {
+    munmap(address, length);
+  }
+}
+
+const char* MappedFile::data() const {
+  return static_cast<const char*>(address);
+}
+
+std::size_t MappedFile::size() const {
+  return length;
+}
@@ -9,114 +9,345 @@
  *  - Driver: Shon Cortes
  *  - Navigator: Arunava Basu
 */
-
 #include <pid.hpp>
 
-#include <iostream>
+#include <chrono>
+#include <cmath>
 #include <stdexcept>
 
-PIDController::PIDController(double kP, double kI, double kD, double max_value,
-                             double min_value, double dt)
+template <typename Scalar>
+BasicPIDController<Scalar>::BasicPIDController(double kP, double kI,
+                                               double kD, double max_value,
+                                               double min_value, double dt)
     :
     kP(kP),
     kI(kI),
     kD(kD),
     max_value(max_value),
     min_value(min_value),
-    prev_error(0),
+    dt(dt),
+    kD_over_dt(Scalar(kD) / Scalar(dt)),
     integral_sum(0),
-    dt(dt) {
-  if (dt <= 0) {
+    prev_error(0),
+    telemetry_sink(nullptr),
+    gain_channel(nullptr),
+    gain_version(0) {
+  // Written so that NaN fails too.
+  if (!(this->dt > Scalar(0))) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+}
+
+template <typename Scalar>
+BasicPIDController<Scalar>::~BasicPIDController() {
+}
+
+template <typename Scalar>
+double BasicPIDController<Scalar>::compute(double setpoint_value,
+                                           double measured_value) noexcept {
+  return static_cast<double>(
+      compute_native(Scalar(setpoint_value), Scalar(measured_value)));
+}
+
+template <typename Scalar>
+Scalar BasicPIDController<Scalar>::compute_native(
+    Scalar setpoint_value, Scalar measured_value) noexcept {
+  return update(setpoint_value, measured_value, nullptr);
+}
+
+template <typename Scalar>
+double BasicPIDController<Scalar>::compute_with_dt(double setpoint_value,
+                                                   double measured_value,
+                                                   double elapsed) {
+  const Scalar step(elapsed);
+  if (!(step > Scalar(0))) {
     throw std::invalid_argument("dt should be greater than 0.");
   }
+  return static_cast<double>(
+      update(Scalar(setpoint_value), Scalar(measured_value), &step));
 }
 
-PIDController::~PIDController() {
+template <typename Scalar>
+PIDResult<double> BasicPIDController<Scalar>::try_compute_with_dt(
+    double setpoint_value, double measured_value, double elapsed) noexcept {
+  const Scalar step(elapsed);
+  if (!(step > Scalar(0))) {
+    return {PIDStatus::invalid_dt, 0.0};
+  }
+  return {PIDStatus::ok,
+          static_cast<double>(update(Scalar(setpoint_value),
+                                     Scalar(measured_value), &step))};
 }
 
-double PIDController::compute(double setpoint_value, double measured_value) {
-  std::cout << "Target setpoint value: " << setpoint_value << std::endl;
-  std::cout << "Measured value: " << measured_value << std::endl;
+template <typename Scalar>
+Scalar BasicPIDController<Scalar>::update(Scalar setpoint_value,
+                                          Scalar measured_value,
+                                          const Scalar* step) noexcept {
+#ifdef PID_INSTRUMENTATION
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  const double integral_before = std::fabs(static_cast<double>(integral_sum));
+#endif
+  if (gain_channel != nullptr) {
+    GainUpdate pending;
+    if (gain_channel->poll(&gain_version, &pending)) {
+      apply_gain_update(pending);
+    }
+  }
+
+  Scalar error = setpoint_value - measured_value;
 
-  double error = setpoint_value - measured_value;
+  Scalar proportional_out = kP * error;
 
-  double proportional_out = kP * error;
+  // A variable step divides kD by the same value the setters would, so
+  // passing step == dt gives the same result as the fixed-step path.
+  Scalar sample_dt = dt;
+  Scalar derivative_gain = kD_over_dt;
+  if (step != nullptr) {
+    sample_dt = *step;
+    derivative_gain = kD / sample_dt;
+  }
 
-  integral_sum += error * dt;
-  double integral_out = kI * integral_sum;
+  integral_sum += error * sample_dt;
+  Scalar integral_out = kI * integral_sum;
 
-  double derivative = (error - prev_error) / dt;
-  double derivative_out = kD * derivative;
+  Scalar derivative_out = derivative_gain * (error - prev_error);
 
-  double output = proportional_out + integral_out + derivative_out;
+  Scalar output = proportional_out + integral_out + derivative_out;
 
+  int32_t saturated = 0;
   if (output > max_value) {
     output = max_value;
+    saturated = 1;
   } else if (output < min_value) {
     output = min_value;
+    saturated = -1;
   }
 
   prev_error = error;
 
+  if (telemetry_sink != nullptr) {
+    TelemetryRecord record;
+    record.timestamp_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    record.setpoint = static_cast<double>(setpoint_value);
+    record.measured = static_cast<double>(measured_value);
+    record.error = static_cast<double>(error);
+    record.proportional = static_cast<double>(proportional_out);
+    record.integral = static_cast<double>(integral_out);
+    record.derivative = static_cast<double>(derivative_out);
+    record.output = static_cast<double>(output);
+    record.saturated = saturated;
+    record.reserved = 0;
+    telemetry_sink->try_push(record);
+  }
+
+#ifdef PID_INSTRUMENTATION
+  instrumentation.record(
+      static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start).count()),
+      saturated, integral_before,
+      std::fabs(static_cast<double>(integral_sum)));
+#endif
+
   return output;
 }
 
-double PIDController::get_dt() const {
-  return dt;
+template <typename Scalar>
+double BasicPIDController<Scalar>::get_dt() const {
+  return static_cast<double>(dt);
 }
 
-void PIDController::set_dt(double dT) {
-  if (dT <= 0) {
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_dt(double dT) {
+  if (try_set_dt(dT) != PIDStatus::ok) {
     throw std::invalid_argument("dt should be greater than 0.");
-  } else {
-    this->dt = dT;
   }
 }
 
-double PIDController::get_kD() const {
-  return kD;
+template <typename Scalar>
+PIDStatus BasicPIDController<Scalar>::try_set_dt(double dT) noexcept {
+  Scalar converted(dT);
+  if (!(converted > Scalar(0))) {
+    return PIDStatus::invalid_dt;
+  }
+  this->dt = converted;
+  kD_over_dt = kD / converted;
+  return PIDStatus::ok;
+}
+
+template <typename Scalar>
+double BasicPIDController<Scalar>::get_kD() const {
+  return static_cast<double>(kD);
+}
+
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_kD(double kd) {
+  this->kD = Scalar(kd);
+  kD_over_dt = this->kD / dt;
 }
 
-void PIDController::set_kD(double kd) {
-  this->kD = kd;
+template <typename Scalar>
+double BasicPIDController<Scalar>::get_kI() const {
+return static_cast<double>(kI);
 }
 
-double PIDController::get_kI() const {
-return kI;
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_kI(double ki) {
+  this->kI = Scalar(ki);
 }
 
-void PIDController::set_kI(double ki) {
-  this->kI = ki;
+template <typename Scalar>
+double BasicPIDController<Scalar>::get_kP() const {
+return static_cast<double>(kP);
 }
 
-double PIDController::get_kP() const {
-return kP;
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_kP(double kp) {
+  this->kP = Scalar(kp);
 }
 
-void PIDController::set_kP(double kp) {
-  this->kP = kp;
+template <typename Scalar>
+double BasicPIDController<Scalar>::get_max_value() const {
+return static_cast<double>(max_value);
 }
 
-double PIDController::get_max_value() const {
-return max_value;
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_max_value(double maxValue) {
+max_value = Scalar(maxValue);
 }
 
-void PIDController::set_max_value(double maxValue) {
-max_value = maxValue;
+template <typename Scalar>
+double BasicPIDController<Scalar>::get_min_value() const {
+return static_cast<double>(min_value);
 }
 
-double PIDController::get_min_value() const {
-return min_value;
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_min_value(double minValue) {
+min_value = Scalar(minValue);
 }
 
-void PIDController::set_min_value(double minValue) {
-min_value = minValue;
+template <typename Scalar>
+double BasicPIDController<Scalar>::get_prev_error() const {
+return static_cast<double>(prev_error);
 }
 
-double PIDController::get_prev_error() const {
-return prev_error;
+template <typename Scalar>
+double BasicPIDController<Scalar>::get_integral_sum() const {
+return static_cast<double>(integral_sum);
 }
 
-double PIDController::get_integral_sum() const {
-return integral_sum;
+template <typename Scalar>
+void BasicPIDController<Scalar>::reset() {
+integral_sum = Scalar(0);
+prev_error = Scalar(0);
 }
+
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_state(double integral_sum,
+                                           double prev_error) {
+  this->integral_sum = Scalar(integral_sum);
+  this->prev_error = Scalar(prev_error);
+}
+
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_telemetry_sink(
+    TelemetryRingBuffer* sink) {
+  telemetry_sink = sink;
+}
+
+template <typename Scalar>
+TelemetryRingBuffer* BasicPIDController<Scalar>::get_telemetry_sink() const {
+  return telemetry_sink;
+}
+
+template <typename Scalar>
+GainSet BasicPIDController<Scalar>::get_gains() const {
+  GainSet gains;
+  gains.kP = static_cast<double>(kP);
+  gains.kI = static_cast<double>(kI);
+  gains.kD = static_cast<double>(kD);
+  gains.max_value = static_cast<double>(max_value);
+  gains.min_value = static_cast<double>(min_value);
+  gains.dt = static_cast<double>(dt);
+  return gains;
+}
+
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_gains(const GainSet& gains) {
+  if (try_set_gains(gains) != PIDStatus::ok) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+}
+
+template <typename Scalar>
+PIDStatus BasicPIDController<Scalar>::try_set_gains(
+    const GainSet& gains) noexcept {
+  if (try_set_dt(gains.dt) != PIDStatus::ok) {
+    return PIDStatus::invalid_dt;
+  }
+  kP = Scalar(gains.kP);
+  kI = Scalar(gains.kI);
+  set_kD(gains.kD);
+  max_value = Scalar(gains.max_value);
+  min_value = Scalar(gains.min_value);
+  return PIDStatus::ok;
+}
+
+template <typename Scalar>
+PIDStatus BasicPIDController<Scalar>::check_gains(
+    const GainSet& gains) noexcept {
+  // Same test as the constructor and try_set_dt().
+  return !(Scalar(gains.dt) > Scalar(0)) ? PIDStatus::invalid_dt
+                                          : PIDStatus::ok;
+}
+
+template <typename Scalar>
+void BasicPIDController<Scalar>::set_gain_channel(
+    GainUpdateChannel* channel) {
+  gain_channel = channel;
+  gain_version = 0;
+}
+
+template <typename Scalar>
+GainUpdateChannel* BasicPIDController<Scalar>::get_gain_channel() const {
+  return gain_channel;
+}
+
+template <typename Scalar>
+void BasicPIDController<Scalar>::apply_gain_update(
+    const GainUpdate& update) noexcept {
+  const GainSet& gains = update.gains;
+  // The channel only accepts dt > 0, so this only fails if dt rounds to 0
+  // in Scalar.
+  if (check_gains(gains) != PIDStatus::ok) {
+    return;
+  }
+  const Scalar new_kP(gains.kP);
+  const Scalar new_kI(gains.kI);
+  // Bumpless transfer: pick integral_sum so that P + I at the last error is
+  // the same under the new gains as under the old ones.
+  if (update.bumpless && new_kI != Scalar(0)) {
+    integral_sum = (kI * integral_sum + (kP - new_kP) * prev_error) / new_kI;
+  }
+  try_set_gains(gains);
+}
+
+#ifdef PID_INSTRUMENTATION
+template <typename Scalar>
+const ComputeInstrumentation&
+BasicPIDController<Scalar>::get_instrumentation() const {
+  return instrumentation;
+}
+
+template <typename Scalar>
+void BasicPIDController<Scalar>::clear_instrumentation() {
+  instrumentation.clear();
+}
+#endif
+
+template class BasicPIDController<float>;
+template class BasicPIDController<double>;
+template class BasicPIDController<Q16_16>;
@@ -0,0 +1,346 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <pid_bank.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PID_BANK_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const std::size_t kAlignment = 64;
+const std::size_t kDoublesPerLine = kAlignment / sizeof(double);
+const std::size_t kArrayCount = 9;
+
+/**
+ * @brief Pointers to the arrays of the bank, handed to the compute kernels
+ *
+ */
+struct BankArrays {
+  const double* kP;
+  const double* kI;
+  const double* max_value;
+  const double* min_value;
+  const double* dt;
+  const double* kD_over_dt;
+  double* integral_sum;
+  double* prev_error;
+};
+
+// Same operations, in the same order, as PIDController::compute().
+void compute_scalar(const BankArrays& a, const double* setpoints,
+                    const double* measured, double* out, std::size_t begin,
+                    std::size_t end) {
+  for (std::size_t i = begin; i < end; ++i) {
+    double error = setpoints[i] - measured[i];
+    double proportional_out = a.kP[i] * error;
+    a.integral_sum[i] += error * a.dt[i];
+    double integral_out = a.kI[i] * a.integral_sum[i];
+    double derivative_out = a.kD_over_dt[i] * (error - a.prev_error[i]);
+    double output = proportional_out + integral_out + derivative_out;
+    if (output > a.max_value[i]) {
+      output = a.max_value[i];
+    } else if (output < a.min_value[i]) {
+      output = a.min_value[i];
+    }
+    a.prev_error[i] = error;
+    out[i] = output;
+  }
+}
+
+#ifdef PID_BANK_X86
+
+// The vector kernels only use IEEE add, sub and mul in the scalar
+// order, so every lane rounds exactly like compute_scalar(). The clamp is
+// expressed as masks: output > max ? max : (output < min ? min : output).
+
+__attribute__((target("sse2")))
+std::size_t compute_sse2(const BankArrays& a, const double* setpoints,
+                         const double* measured, double* out, std::size_t n) {
+  const std::size_t vector_end = n & ~static_cast<std::size_t>(1);
+  for (std::size_t i = 0; i < vector_end; i += 2) {
+    __m128d error = _mm_sub_pd(_mm_loadu_pd(setpoints + i),
+                               _mm_loadu_pd(measured + i));
+    __m128d dt = _mm_load_pd(a.dt + i);
+    __m128d proportional_out = _mm_mul_pd(_mm_load_pd(a.kP + i), error);
+    __m128d integral_sum = _mm_add_pd(_mm_load_pd(a.integral_sum + i),
+                                      _mm_mul_pd(error, dt));
+    __m128d integral_out = _mm_mul_pd(_mm_load_pd(a.kI + i), integral_sum);
+    __m128d derivative_out = _mm_mul_pd(
+        _mm_load_pd(a.kD_over_dt + i),
+        _mm_sub_pd(error, _mm_load_pd(a.prev_error + i)));
+    __m128d output = _mm_add_pd(_mm_add_pd(proportional_out, integral_out),
+                                derivative_out);
+
+    __m128d max_value = _mm_load_pd(a.max_value + i);
+    __m128d min_value = _mm_load_pd(a.min_value + i);
+    __m128d above = _mm_cmpgt_pd(output, max_value);
+    __m128d below = _mm_cmplt_pd(output, min_value);
+    output = _mm_or_pd(_mm_and_pd(below, min_value),
+                       _mm_andnot_pd(below, output));
+    output = _mm_or_pd(_mm_and_pd(above, max_value),
+                       _mm_andnot_pd(above, output));
+
+    _mm_store_pd(a.integral_sum + i, integral_sum);
+    _mm_store_pd(a.prev_error + i, error);
+    _mm_storeu_pd(out + i, output);
+  }
+  return vector_end;
+}
+
+__attribute__((target("avx")))
+std::size_t compute_avx(const BankArrays& a, const double* setpoints,
+                        const double* measured, double* out, std::size_t n) {
+  const std::size_t vector_end = n & ~static_cast<std::size_t>(3);
+  for (std::size_t i = 0; i < vector_end; i += 4) {
+    __m256d error = _mm256_sub_pd(_mm256_loadu_pd(setpoints + i),
+                                  _mm256_loadu_pd(measured + i));
+    __m256d dt = _mm256_load_pd(a.dt + i);
+    __m256d proportional_out = _mm256_mul_pd(_mm256_load_pd(a.kP + i), error);
+    __m256d integral_sum = _mm256_add_pd(_mm256_load_pd(a.integral_sum + i),
+                                         _mm256_mul_pd(error, dt));
+    __m256d integral_out = _mm256_mul_pd(_mm256_load_pd(a.kI + i),
+                                         integral_sum);
+    __m256d derivative_out = _mm256_mul_pd(
+        _mm256_load_pd(a.kD_over_dt + i),
+        _mm256_sub_pd(error, _mm256_load_pd(a.prev_error + i)));
+    __m256d output = _mm256_add_pd(
+        _mm256_add_pd(proportional_out, integral_out), derivative_out);
+
+    __m256d max_value = _mm256_load_pd(a.max_value + i);
+    __m256d min_value = _mm256_load_pd(a.min_value + i);
+    __m256d above = _mm256_cmp_pd(output, max_value, _CMP_GT_OQ);
+    __m256d below = _mm256_cmp_pd(output, min_value, _CMP_LT_OQ);
+    output = _mm256_blendv_pd(output, min_value, below);
+    output = _mm256_blendv_pd(output, max_value, above);
+
+    _mm256_store_pd(a.integral_sum + i, integral_sum);
+    _mm256_store_pd(a.prev_error + i, error);
+    _mm256_storeu_pd(out + i, output);
+  }
+  return vector_end;
+}
+
+#endif  // PID_BANK_X86
+
+std::size_t round_up_to_line(std::size_t n) {
+  return (n + kDoublesPerLine - 1) / kDoublesPerLine * kDoublesPerLine;
+}
+
+}  // namespace
+
+PIDControllerBank::PIDControllerBank(std::size_t capacity)
+    :
+    count(0),
+    capacity(0),
+    kernel(best_kernel()),
+    storage(nullptr),
+    kP(nullptr),
+    kI(nullptr),
+    kD(nullptr),
+    max_value(nullptr),
+    min_value(nullptr),
+    dt(nullptr),
+    kD_over_dt(nullptr),
+    integral_sum(nullptr),
+    prev_error(nullptr) {
+  if (capacity > 0) {
+    grow(capacity);
+  }
+}
+
+PIDControllerBank::~PIDControllerBank() {
+  std::free(storage);
+}
+
+std::size_t PIDControllerBank::add(double kp, double ki, double kd,
+                                   double maxValue, double minValue,
+                                   double dT) {
+  if (!(dT > 0)) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+  if (count == capacity) {
+    grow(capacity == 0 ? kDoublesPerLine : capacity * 2);
+  }
+  std::size_t index = count++;
+  kP[index] = kp;
+  kI[index] = ki;
+  kD[index] = kd;
+  max_value[index] = maxValue;
+  min_value[index] = minValue;
+  dt[index] = dT;
+  kD_over_dt[index] = kd / dT;
+  integral_sum[index] = 0;
+  prev_error[index] = 0;
+  return index;
+}
+
+std::size_t PIDControllerBank::size() const {
+  return count;
+}
+
+void PIDControllerBank::compute(const double* setpoints,
+                                const double* measured, double* out,
+                                std::size_t n) {
+  if (n > count) {
+    throw std::invalid_argument("n should not exceed the bank size.");
+  }
+  BankArrays arrays = {kP, kI, max_value, min_value, dt, kD_over_dt,
+                       integral_sum, prev_error};
+  std::size_t done = 0;
+#ifdef PID_BANK_X86
+  if (kernel == Kernel::avx) {
+    done = compute_avx(arrays, setpoints, measured, out, n);
+  } else if (kernel == Kernel::sse2) {
+    done = compute_sse2(arrays, setpoints, measured, out, n);
+  }
+#endif
+  compute_scalar(arrays, setpoints, measured, out, done, n);
+}
+
+void PIDControllerBank::set_kernel(Kernel requested) {
+  Kernel best = best_kernel();
+  kernel = static_cast<int>(requested) <= static_cast<int>(best) ? requested
+                                                                 : best;
+}
+
+PIDControllerBank::Kernel PIDControllerBank::get_kernel() const {
+  return kernel;
+}
+
+PIDControllerBank::Kernel PIDControllerBank::best_kernel() {
+#ifdef PID_BANK_X86
+  static const Kernel best =
+      __builtin_cpu_supports("avx") ? Kernel::avx
+      : __builtin_cpu_supports("sse2") ? Kernel::sse2 : Kernel::scalar;
+  return best;
+#else
+  return Kernel::scalar;
+#endif
+}
+
+void PIDControllerBank::grow(std::size_t new_capacity) {
+  new_capacity = round_up_to_line(new_capacity);
+  void* raw = nullptr;
+  if (posix_memalign(&raw, kAlignment,
+                     kArrayCount * new_capacity * sizeof(double)) != 0) {
+    throw std::bad_alloc();
+  }
+  double* base = static_cast<double*>(raw);
+  double** arrays[kArrayCount] = {&kP, &kI, &kD, &max_value, &min_value,
+                                  &dt, &kD_over_dt, &integral_sum,
+                                  &prev_error};
+  for (std::size_t k = 0; k < kArrayCount; ++k) {
+    double* fresh = base + k * new_capacity;
+    if (count > 0) {
+      std::memcpy(fresh, *arrays[k], count * sizeof(double));
+    }
+    *arrays[k] = fresh;
+  }
+  std::free(storage);
+  storage = raw;
+  capacity = new_capacity;
+}
+
+void PIDControllerBank::check_index(std::size_t index) const {
+  if (index >= count) {
+    throw std::out_of_range("controller index out of range.");
+  }
+}
+
+double PIDControllerBank::get_dt(std::size_t index) const {
+  check_index(index);
+  return dt[index];
+}
+
+void PIDControllerBank::set_dt(std::size_t index, double dT) {
+  check_index(index);
+  if (!(dT > 0)) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+  dt[index] = dT;
+  kD_over_dt[index] = kD[index] / dT;
+}
+
+double PIDControllerBank::get_kD(std::size_t index) const {
+  check_index(index);
+  return kD[index];
+}
+
+void PIDControllerBank::set_kD(std::size_t index, double kd) {
+  check_index(index);
+  kD[index] = kd;
+  kD_over_dt[index] = kd / dt[index];
+}
+
+double PIDControllerBank::get_kI(std::size_t index) const {
+  check_index(index);
+  return kI[index];
+}
+
+void PIDControllerBank::set_kI(std::size_t index, double ki) {
+  check_index(index);
+  kI[index] = ki;
+}
+
+double PIDControllerBank::get_kP(std::size_t index) const {
+  check_index(index);
+  return kP[index];
+}
+
+void PIDControllerBank::set_kP(std::size_t index, double kp) {
+  check_index(index);
+  kP[index] = kp;
+}
+
+double PIDControllerBank::get_max_value(std::size_t index) const {
+  check_index(index);
+  return max_value[index];
+}
+
+void PIDControllerBank::set_max_value(std::size_t index, double maxValue) {
+  check_index(index);
+  max_value[index] = maxValue;
+}
+
+double PIDControllerBank::get_min_value(std::size_t index) const {
+  check_index(index);
+  return min_value[index];
+}
+
+void PIDControllerBank::set_min_value(std::size_t index, double minValue) {
+  check_index(index);
+  min_value[index] = minValue;
+}
+
+double PIDControllerBank::get_prev_error(std::size_t index) const {
+  check_index(index);
+  return prev_error[index];
+}
+
+double PIDControllerBank::get_integral_sum(std::size_t index) const {
+  check_index(index);
+  return integral_sum[index];
+}
+
+void PIDControllerBank::set_state(std::size_t index, double integral,
+                                  double prev) {
+  check_index(index);
+  integral_sum[index] = integral;
+  prev_error[index] = prev;
+}
@@ -0,0 +1,119 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <plant.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+PlantParams first_order_plant(double gain, double time_constant,
+                              double dead_time) {
+  PlantParams params = {PlantType::first_order, gain, time_constant, 0, 0,
+                        dead_time};
+  return params;
+}
+
+PlantParams second_order_plant(double gain, double natural_frequency,
+                               double damping, double dead_time) {
+  PlantParams params = {PlantType::second_order, gain, 0, natural_frequency,
+                        damping, dead_time};
+  return params;
+}
+
+PlantParams dead_time_plant(double gain, double dead_time) {
+  PlantParams params = {PlantType::dead_time, gain, 0, 0, 0, dead_time};
+  return params;
+}
+
+DiscretePlantModel discretize(const PlantParams& params, double dt) {
+  if (dt <= 0) {
+    throw std::invalid_argument("dt should be greater than 0.");
+  }
+  if (params.dead_time < 0) {
+    throw std::invalid_argument("dead_time should not be negative.");
+  }
+  DiscretePlantModel model = {0, 0, 0, 0, 0, 0, 0};
+  model.delay_samples =
+      static_cast<std::size_t>(std::llround(params.dead_time / dt));
+
+  switch (params.type) {
+    case PlantType::first_order: {
+      if (params.time_constant <= 0) {
+        throw std::invalid_argument("time_constant should be greater than 0.");
+      }
+      double a = std::exp(-dt / params.time_constant);
+      model.a11 = a;
+      model.b1 = (1 - a) * params.gain;
+      break;
+    }
+    case PlantType::second_order: {
+      if (params.natural_frequency <= 0) {
+        throw std::invalid_argument(
+            "natural_frequency should be greater than 0.");
+      }
+      // v += dt (K wn^2 u - 2 zeta wn v - wn^2 y);  y += dt v
+      double wn2 = params.natural_frequency * params.natural_frequency;
+      double friction = 1 - 2 * params.damping * params.natural_frequency * dt;
+      model.a21 = -dt * wn2;
+      model.a22 = friction;
+      model.a11 = 1 - dt * dt * wn2;
+      model.a12 = dt * friction;
+      model.b2 = dt * params.gain * wn2;
+      model.b1 = dt * model.b2;
+      break;
+    }
+    case PlantType::dead_time:
+      model.b1 = params.gain;
+      break;
+    default:
+      throw std::invalid_argument("unknown plant type.");
+  }
+  return model;
+}
+
+DiscretePlant::DiscretePlant(const PlantParams& params, double dt)
+    :
+    model(discretize(params, dt)),
+    dt(dt),
+    x1(0),
+    x2(0),
+    delay_line(model.delay_samples, 0.0),
+    delay_head(0) {
+}
+
+double DiscretePlant::output() const {
+  return x1;
+}
+
+double DiscretePlant::get_dt() const {
+  return dt;
+}
+
+void DiscretePlant::step(double input) {
+  double u = input;
+  if (!delay_line.empty()) {
+    u = delay_line[delay_head];
+    delay_line[delay_head] = input;
+    delay_head = (delay_head + 1) % delay_line.size();
+  }
+  double next1 = model.a11 * x1 + model.a12 * x2 + model.b1 * u;
+  double next2 = model.a21 * x1 + model.a22 * x2 + model.b2 * u;
+  x1 = next1;
+  x2 = next2;
+}
+
+void DiscretePlant::reset() {
+  x1 = 0;
+  x2 = 0;
+  std::fill(delay_line.begin(), delay_line.end(), 0.0);
+  delay_head = 0;
+}
@@ -0,0 +1,303 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <robustness.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include <parallel.hpp>
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Number of partial reports the chunks are spread over. Fixed, so the
+// merge order and hence the report do not depend on the thread count.
+const std::size_t kPartials = 64;
+
+void check_spread(const ParameterSpread& parameter) {
+  const double limit =
+      parameter.distribution == Distribution::normal ? 1.0 / 3.0 : 1.0;
+  if (parameter.distribution != Distribution::fixed &&
+      !(parameter.spread >= 0 && parameter.spread < limit)) {
+    throw std::invalid_argument(
+        "spread should be in [0, 1) for uniform and [0, 1/3) for normal.");
+  }
+}
+
+double draw(double nominal, const ParameterSpread& parameter,
+            std::mt19937_64* rng) {
+  double offset = 0;
+  if (parameter.distribution == Distribution::uniform) {
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    offset = uniform(*rng);
+  } else if (parameter.distribution == Distribution::normal) {
+    std::normal_distribution<double> normal(0.0, 1.0);
+    offset = std::max(-3.0, std::min(3.0, normal(*rng)));
+  } else {
+    return nominal;
+  }
+  return nominal * (1.0 + parameter.spread * offset);
+}
+
+PlantParams draw_plant(const PlantDistribution& plants,
+                       std::mt19937_64* rng) {
+  PlantParams plant = plants.nominal;
+  plant.gain = draw(plant.gain, plants.gain, rng);
+  plant.time_constant = draw(plant.time_constant, plants.time_constant, rng);
+  plant.natural_frequency =
+      draw(plant.natural_frequency, plants.natural_frequency, rng);
+  plant.damping = draw(plant.damping, plants.damping, rng);
+  plant.dead_time = draw(plant.dead_time, plants.dead_time, rng);
+  return plant;
+}
+
+RobustnessReport make_report(const GainSet& gains,
+                             const PlantDistribution& plants,
+                             const RobustnessOptions& options) {
+  const double horizon = static_cast<double>(options.simulation.steps) *
+                         gains.dt;
+  RobustnessReport report = {
+      0, 0, 0,
+      Histogram(0.0, options.max_overshoot, options.histogram_bins),
+      Histogram(0.0, horizon, options.histogram_bins),
+      Histogram(0.0, horizon * std::fabs(options.simulation.setpoint),
+                options.histogram_bins),
+      plants.nominal, 0.0};
+  return report;
+}
+
+void add_sample(const PlantParams& plant, const StepResponseMetrics& metrics,
+                RobustnessReport* report) {
+  ++report->samples;
+  if (metrics.diverged) {
+    ++report->diverged;
+  } else {
+    report->overshoot.add(metrics.overshoot);
+    report->iae.add(metrics.iae);
+    if (metrics.settled) {
+      ++report->settled;
+      report->settling_time.add(metrics.settling_time);
+    }
+  }
+  // Diverged samples have an infinite IAE; the first one is kept.
+  if (report->samples == 1 || metrics.iae > report->worst_iae) {
+    report->worst_plant = plant;
+    report->worst_iae = metrics.iae;
+  }
+}
+
+void merge_report(const RobustnessReport& partial, RobustnessReport* report) {
+  if (partial.samples == 0) {
+    return;
+  }
+  if (report->samples == 0 || partial.worst_iae > report->worst_iae) {
+    report->worst_plant = partial.worst_plant;
+    report->worst_iae = partial.worst_iae;
+  }
+  report->samples += partial.samples;
+  report->settled += partial.settled;
+  report->diverged += partial.diverged;
+  report->overshoot.merge(partial.overshoot);
+  report->settling_time.merge(partial.settling_time);
+  report->iae.merge(partial.iae);
+}
+
+}  // namespace
+
+Histogram::Histogram(double lower, double upper, std::size_t bins)
+    :
+    lower(lower),
+    upper(upper),
+    bin_width(0),
+    count(0),
+    sum(0),
+    min_value(0),
+    max_value(0) {
+  if (!(lower < upper) || bins == 0) {
+    throw std::invalid_argument(
+        "histogram needs lower < upper and at least one bin.");
+  }
+  bin_width = (upper - lower) / static_cast<double>(bins);
+  this->bins.assign(bins + 2, 0);
+}
+
+void Histogram::add(double value) {
+  if (std::isnan(value)) {
+    return;
+  }
+  std::size_t bin;
+  if (value < lower) {
+    bin = 0;
+  } else if (value >= upper) {
+    bin = bins.size() - 1;
+  } else {
+    bin = 1 + std::min(bins.size() - 3, static_cast<std::size_t>(
+                                            (value - lower) / bin_width));
+  }
+  ++bins[bin];
+  if (count == 0) {
+    min_value = value;
+    max_value = value;
+  } else {
+    min_value = std::min(min_value, value);
+    max_value = std::max(max_value, value);
+  }
+  ++count;
+  sum += value;
+}
+
+void Histogram::merge(const Histogram& other) {
+  if (other.lower != lower || other.upper != upper ||
+      other.bins.size() != bins.size()) {
+    throw std::invalid_argument("histogram layouts differ.");
+  }
+  if (other.count == 0) {
+    return;
+  }
+  for (std::size_t bin = 0; bin < bins.size(); ++bin) {
+    bins[bin] += other.bins[bin];
+  }
+  if (count == 0) {
+    min_value = other.min_value;
+    max_value = other.max_value;
+  } else {
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+  }
+  count += other.count;
+  sum += other.sum;
+}
+
+uint64_t Histogram::get_count() const {
+  return count;
+}
+
+double Histogram::get_min() const {
+  return min_value;
+}
+
+double Histogram::get_max() const {
+  return max_value;
+}
+
+double Histogram::get_mean() const {
+  return count == 0 ? 0.0 : sum / static_cast<double>(count);
+}
+
+double Histogram::get_percentile(double quantile) const {
+  if (count == 0) {
+    return 0;
+  }
+  uint64_t rank = static_cast<uint64_t>(quantile * count);
+  if (rank >= count) {
+    rank = count - 1;
+  }
+  uint64_t seen = 0;
+  for (std::size_t bin = 0; bin < bins.size(); ++bin) {
+    seen += bins[bin];
+    if (seen > rank) {
+      if (bin == 0) {
+        return min_value;
+      }
+      if (bin == bins.size() - 1) {
+        return max_value;
+      }
+      const double edge = lower + static_cast<double>(bin) * bin_width;
+      return std::max(min_value, std::min(max_value, edge));
+    }
+  }
+  return max_value;
+}
+
+double RobustnessReport::get_stability_rate() const {
+  return samples == 0 ? 0.0
+                      : static_cast<double>(samples - diverged) /
+                            static_cast<double>(samples);
+}
+
+double RobustnessReport::get_settled_rate() const {
+  return samples == 0 ? 0.0
+                      : static_cast<double>(settled) /
+                            static_cast<double>(samples);
+}
+
+PlantDistribution uniform_spread(const PlantParams& nominal, double spread) {
+  ParameterSpread parameter;
+  parameter.distribution = Distribution::uniform;
+  parameter.spread = spread;
+  check_spread(parameter);
+  PlantDistribution plants;
+  plants.nominal = nominal;
+  plants.gain = parameter;
+  plants.time_constant = parameter;
+  plants.natural_frequency = parameter;
+  plants.damping = parameter;
+  plants.dead_time = parameter;
+  return plants;
+}
+
+RobustnessReport analyze_robustness(const GainSet& gains,
+                                    const PlantDistribution& plants,
+                                    const RobustnessOptions& options) {
+  if (options.samples == 0) {
+    throw std::invalid_argument("samples should be greater than 0.");
+  }
+  check_spread(plants.gain);
+  check_spread(plants.time_constant);
+  check_spread(plants.natural_frequency);
+  check_spread(plants.damping);
+  check_spread(plants.dead_time);
+  // Validates dt and the nominal plant before any thread is started; the
+  // spreads above keep every drawn parameter on the same side of 0.
+  discretize(plants.nominal, gains.dt);
+
+  SimulationOptions simulation = options.simulation;
+  simulation.record_trajectory = false;
+  const std::size_t chunk_size = ClosedLoopSimulator::kChunkSize;
+  const std::size_t chunks = (options.samples + chunk_size - 1) / chunk_size;
+  const std::size_t partials = std::min(chunks, kPartials);
+  std::vector<RobustnessReport> reports(
+      partials, make_report(gains, plants, options));
+
+  parallel_for(partials, options.threads, [&](std::size_t p) {
+    std::vector<PlantParams> drawn(chunk_size);
+    for (std::size_t chunk = p; chunk < chunks; chunk += partials) {
+      std::seed_seq seeds = {static_cast<uint32_t>(options.seed),
+                             static_cast<uint32_t>(options.seed >> 32),
+                             static_cast<uint32_t>(chunk),
+                             static_cast<uint32_t>(
+                                 static_cast<uint64_t>(chunk) >> 32)};
+      std::mt19937_64 rng(seeds);
+      const std::size_t begin = chunk * chunk_size;
+      const std::size_t end = std::min(options.samples, begin + chunk_size);
+      ClosedLoopSimulator simulator;
+      for (std::size_t i = begin; i < end; ++i) {
+        drawn[i - begin] = draw_plant(plants, &rng);
+        simulator.add(gains, drawn[i - begin]);
+      }
+      std::vector<StepResponseMetrics> metrics = simulator.run(simulation, 1);
+      for (std::size_t i = 0; i < metrics.size(); ++i) {
+        add_sample(drawn[i], metrics[i], &reports[p]);
+      }
+    }
+  });
+
+  RobustnessReport report = make_report(gains, plants, options);
+  for (const RobustnessReport& partial : reports) {
+    merge_report(partial, &report);
+  }
+  return report;
+}
@@ -0,0 +1,153 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <sensor_ingest.hpp>
+
+#include <stdexcept>
+
+namespace {
+
+void bump(std::atomic<uint64_t>* counter, uint64_t amount) {
+  counter->store(counter->load(std::memory_order_relaxed) + amount,
+                 std::memory_order_relaxed);
+}
+
+}  // namespace
+
+SensorIngest::SensorIngest(std::size_t queue_capacity)
+    :
+    queue_capacity(queue_capacity),
+    batch(kBatchSize) {
+  if (queue_capacity == 0) {
+    throw std::invalid_argument("capacity should be greater than 0.");
+  }
+}
+
+std::size_t SensorIngest::add_channel(PIDController* controller,
+                                      double setpoint, IngestMode mode) {
+  if (controller == nullptr) {
+    throw std::invalid_argument("controller should not be null.");
+  }
+  std::unique_ptr<Channel> channel(new Channel());
+  channel->controller = controller;
+  channel->mode = mode;
+  channel->has_timestamp = false;
+  channel->setpoint = setpoint;
+  channel->last_timestamp = 0;
+  channel->last_version = 0;
+  channel->output = 0;
+  channel->computed.store(0, std::memory_order_relaxed);
+  channel->overwritten.store(0, std::memory_order_relaxed);
+  channel->out_of_order.store(0, std::memory_order_relaxed);
+  if (mode == IngestMode::queue) {
+    channel->queue.reset(new SpscRingBuffer<SensorSample>(queue_capacity));
+  }
+  channels.push_back(std::move(channel));
+  return channels.size() - 1;
+}
+
+std::size_t SensorIngest::get_channel_count() const {
+  return channels.size();
+}
+
+void SensorIngest::check_channel(std::size_t channel) const {
+  if (channel >= channels.size()) {
+    throw std::out_of_range("channel index out of range.");
+  }
+}
+
+bool SensorIngest::publish(std::size_t channel, const SensorSample& sample) {
+  check_channel(channel);
+  Channel& target = *channels[channel];
+  if (target.mode == IngestMode::queue) {
+    return target.queue->try_push(sample);
+  }
+  target.latest.write(sample);
+  return true;
+}
+
+void SensorIngest::set_setpoint(std::size_t channel, double setpoint) {
+  check_channel(channel);
+  channels[channel]->setpoint = setpoint;
+}
+
+void SensorIngest::compute_sample(Channel* channel,
+                                  const SensorSample& sample) {
+  double elapsed = channel->controller->get_dt();
+  if (channel->has_timestamp) {
+    // Also rejects NaN timestamps.
+    if (!(sample.timestamp > channel->last_timestamp)) {
+      bump(&channel->out_of_order, 1);
+      return;
+    }
+    elapsed = sample.timestamp - channel->last_timestamp;
+  }
+  channel->output = channel->controller->compute_with_dt(
+      channel->setpoint, sample.measured, elapsed);
+  channel->last_timestamp = sample.timestamp;
+  channel->has_timestamp = true;
+  bump(&channel->computed, 1);
+}
+
+std::size_t SensorIngest::drain(double* outputs) {
+  std::size_t computed = 0;
+  for (std::size_t c = 0; c < channels.size(); ++c) {
+    Channel* channel = channels[c].get();
+    const uint64_t before = channel->computed.load(std::memory_order_relaxed);
+    if (channel->mode == IngestMode::queue) {
+      // At most one ring's worth per tick, so a producer that keeps up
+      // with the drain cannot hold the control thread here.
+      std::size_t remaining = channel->queue->capacity();
+      std::size_t wanted;
+      std::size_t count;
+      do {
+        wanted = remaining < kBatchSize ? remaining : kBatchSize;
+        count = channel->queue->pop_batch(batch.data(), wanted);
+        for (std::size_t i = 0; i < count; ++i) {
+          compute_sample(channel, batch[i]);
+        }
+        remaining -= count;
+      } while (count == wanted && remaining > 0);
+    } else if (channel->latest.get_version() != channel->last_version) {
+      SensorSample sample;
+      uint64_t version;
+      // A read racing with a write fails; the sample is picked up on the
+      // next tick.
+      if (channel->latest.try_read(&sample, &version)) {
+        bump(&channel->overwritten, version - channel->last_version - 1);
+        channel->last_version = version;
+        compute_sample(channel, sample);
+      }
+    }
+    computed += channel->computed.load(std::memory_order_relaxed) - before;
+    if (outputs != nullptr) {
+      outputs[c] = channel->output;
+    }
+  }
+  return computed;
+}
+
+double SensorIngest::get_output(std::size_t channel) const {
+  check_channel(channel);
+  return channels[channel]->output;
+}
+
+IngestStats SensorIngest::get_stats(std::size_t channel) const {
+  check_channel(channel);
+  const Channel& source = *channels[channel];
+  IngestStats stats;
+  stats.computed = source.computed.load(std::memory_order_relaxed);
+  stats.dropped =
+      source.queue ? source.queue->get_dropped() : uint64_t(0);
+  stats.overwritten = source.overwritten.load(std::memory_order_relaxed);
+  stats.out_of_order = source.out_of_order.load(std::memory_order_relaxed);
+  return stats;
+}
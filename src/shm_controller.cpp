@@ -0,0 +1,481 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <shm_controller.hpp>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+const char kShmMagic[8] = {'P', 'I', 'D', 'S', 'H', 'M', 'S', 'V'};
+const uint32_t kShmVersion = 1;
+const uint32_t kRingMask = kShmRingCapacity - 1;
+
+static_assert((kShmRingCapacity & kRingMask) == 0,
+              "kShmRingCapacity should be a power of two.");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+              ATOMIC_INT_LOCK_FREE == 2,
+              "futex words must be plain lock-free 32-bit integers.");
+
+struct ShmRequest {
+  double setpoint;
+  double measured;
+};
+
+/**
+ * @brief Header of the segment. Followed by slot_count ShmSlots.
+ *
+ */
+struct ShmHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t slot_count;
+  std::atomic<uint32_t> running;     // 0 once the server has stopped
+  std::atomic<uint32_t> server_pid;  // process running serve()
+  char header_pad[40];
+
+  // Bumped by clients after every submit; futex word of the server.
+  std::atomic<uint32_t> doorbell;
+  std::atomic<uint32_t> server_sleeping;
+  char doorbell_pad[56];
+};
+
+/**
+ * @brief One controller's rings. Counters only grow (modulo 2^32); request
+ * n lives in requests[n % kShmRingCapacity] and its output in the same
+ * index of outputs.
+ *
+ */
+struct ShmSlot {
+  // Written by the client.
+  std::atomic<uint32_t> submitted;
+  std::atomic<uint32_t> client_waiting;
+  char client_pad[56];
+
+  // Written by the server; futex word of the client.
+  std::atomic<uint32_t> completed;
+  char server_pad[60];
+
+  // 0 when free, otherwise the pid of the client that claimed the slot.
+  std::atomic<uint32_t> owner;
+  char owner_pad[60];
+
+  ShmRequest requests[kShmRingCapacity];
+  double outputs[kShmRingCapacity];
+};
+
+static_assert(sizeof(ShmHeader) % 64 == 0 && sizeof(ShmSlot) % 64 == 0,
+              "segment parts should be whole cache lines.");
+
+std::size_t segment_length(std::size_t slot_count) {
+  return sizeof(ShmHeader) + slot_count * sizeof(ShmSlot);
+}
+
+void futex_wait(std::atomic<uint32_t>* word, uint32_t expected,
+                const struct timespec* timeout) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected,
+          timeout, nullptr, 0);
+}
+
+bool process_exists(uint32_t pid) {
+  return pid != 0 &&
+         (kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH);
+}
+
+// Whether a segment of this name belongs to a server that is still running
+bool server_running(const std::string& name) {
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < sizeof(ShmHeader)) {
+    close(fd);
+    return false;
+  }
+  void* address = mmap(nullptr, sizeof(ShmHeader), PROT_READ, MAP_SHARED, fd,
+                       0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    return false;
+  }
+  const ShmHeader* header = static_cast<const ShmHeader*>(address);
+  bool running = header->running.load(std::memory_order_acquire) != 0 &&
+                 process_exists(
+                     header->server_pid.load(std::memory_order_acquire));
+  munmap(address, sizeof(ShmHeader));
+  return running;
+}
+
+void futex_wake(std::atomic<uint32_t>* word) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX,
+          nullptr, nullptr, 0);
+}
+
+}  // namespace
+
+/**
+ * @brief Mapped view of the segment
+ *
+ */
+struct ShmSegment {
+  ShmHeader header;
+
+  ShmSlot* slots() {
+    return reinterpret_cast<ShmSlot*>(this + 1);
+  }
+};
+
+static_assert(sizeof(ShmSegment) == sizeof(ShmHeader),
+              "slots should follow the header directly.");
+
+ShmControllerServer::ShmControllerServer(const std::string& name,
+                                         const std::vector<GainSet>& gains)
+    :
+    name(name),
+    length(segment_length(gains.size())),
+    segment(nullptr),
+    spin(0),
+    served(0) {
+  if (name.size() < 2 || name[0] != '/' ||
+      name.find('/', 1) != std::string::npos) {
+    throw std::invalid_argument("name should look like /name.");
+  }
+  if (gains.empty()) {
+    throw std::invalid_argument("gains should not be empty.");
+  }
+  controllers.reserve(gains.size());
+  for (const GainSet& set : gains) {
+    controllers.emplace_back(set.kP, set.kI, set.kD, set.max_value,
+                             set.min_value, set.dt);
+  }
+
+  // A segment left behind by a stopped or crashed server is replaced; one
+  // of a live server is not.
+  if (server_running(name)) {
+    throw std::runtime_error("shared memory " + name +
+                             " is used by a running server.");
+  }
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("cannot create shared memory " + name);
+  }
+  if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    throw std::runtime_error("cannot resize shared memory " + name);
+  }
+  void* address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    throw std::runtime_error("cannot map shared memory " + name);
+  }
+
+  // The segment starts zero-filled; construct the atomics in place.
+  segment = new (address) ShmSegment();
+  ShmHeader& header = segment->header;
+  header.version = kShmVersion;
+  header.slot_count = static_cast<uint32_t>(gains.size());
+  header.running.store(1, std::memory_order_relaxed);
+  header.server_pid.store(static_cast<uint32_t>(getpid()),
+                          std::memory_order_relaxed);
+  header.doorbell.store(0, std::memory_order_relaxed);
+  header.server_sleeping.store(0, std::memory_order_relaxed);
+  for (std::size_t i = 0; i < gains.size(); ++i) {
+    ShmSlot* slot = new (&segment->slots()[i]) ShmSlot();
+    slot->submitted.store(0, std::memory_order_relaxed);
+    slot->client_waiting.store(0, std::memory_order_relaxed);
+    slot->completed.store(0, std::memory_order_relaxed);
+    slot->owner.store(0, std::memory_order_relaxed);
+  }
+  // Clients check the magic last, so they never see a half-built segment.
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header.magic, kShmMagic, sizeof(kShmMagic));
+}
+
+ShmControllerServer::~ShmControllerServer() {
+  stop();
+  munmap(segment, length);
+  shm_unlink(name.c_str());
+}
+
+std::size_t ShmControllerServer::poll() {
+  std::size_t answered = 0;
+  ShmSlot* slots = segment->slots();
+  for (std::size_t i = 0; i < controllers.size(); ++i) {
+    ShmSlot& slot = slots[i];
+    const uint32_t submitted = slot.submitted.load(std::memory_order_acquire);
+    uint32_t done = slot.completed.load(std::memory_order_relaxed);
+    if (done == submitted) {
+      continue;
+    }
+    for (; done != submitted; ++done) {
+      const ShmRequest& request = slot.requests[done & kRingMask];
+      slot.outputs[done & kRingMask] =
+          controllers[i].compute(request.setpoint, request.measured);
+    }
+    answered += submitted - slot.completed.load(std::memory_order_relaxed);
+    slot.completed.store(done, std::memory_order_seq_cst);
+    if (slot.client_waiting.load(std::memory_order_seq_cst) != 0) {
+      futex_wake(&slot.completed);
+    }
+  }
+  served.store(served.load(std::memory_order_relaxed) + answered,
+               std::memory_order_relaxed);
+  return answered;
+}
+
+void ShmControllerServer::serve() {
+  ShmHeader& header = segment->header;
+  header.server_pid.store(static_cast<uint32_t>(getpid()),
+                          std::memory_order_release);
+  while (header.running.load(std::memory_order_acquire) != 0) {
+    if (poll() > 0) {
+      continue;
+    }
+    bool busy = false;
+    for (unsigned i = 0; i < spin && !busy; ++i) {
+      busy = poll() > 0;
+    }
+    if (busy) {
+      continue;
+    }
+    // Announce the sleep before the last check: a client that submits
+    // after it either sees the flag or changes the doorbell first.
+    header.server_sleeping.store(1, std::memory_order_seq_cst);
+    const uint32_t bell = header.doorbell.load(std::memory_order_seq_cst);
+    if (poll() == 0 && header.running.load(std::memory_order_acquire) != 0) {
+      futex_wait(&header.doorbell, bell, nullptr);
+    }
+    header.server_sleeping.store(0, std::memory_order_relaxed);
+  }
+}
+
+void ShmControllerServer::start() {
+  if (worker.joinable()) {
+    throw std::logic_error("server is already running.");
+  }
+  if (segment->header.running.load(std::memory_order_acquire) == 0) {
+    throw std::logic_error("server was stopped.");
+  }
+  worker = std::thread(&ShmControllerServer::serve, this);
+}
+
+void ShmControllerServer::stop() {
+  ShmHeader& header = segment->header;
+  header.running.store(0, std::memory_order_seq_cst);
+  header.doorbell.fetch_add(1, std::memory_order_seq_cst);
+  futex_wake(&header.doorbell);
+  // Clients sleeping on their slot wake up and see running == 0.
+  for (std::size_t i = 0; i < controllers.size(); ++i) {
+    futex_wake(&segment->slots()[i].completed);
+  }
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+void ShmControllerServer::set_spin(unsigned iterations) {
+  spin = iterations;
+}
+
+std::size_t ShmControllerServer::get_slot_count() const {
+  return controllers.size();
+}
+
+uint64_t ShmControllerServer::get_served() const {
+  return served.load(std::memory_order_relaxed);
+}
+
+ShmControllerClient::ShmControllerClient(const std::string& name,
+                                         std::size_t slot)
+    :
+    length(0),
+    segment(nullptr),
+    slot(slot),
+    submitted(0),
+    received(0),
+    spin(0) {
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    throw std::runtime_error("cannot open shared memory " + name);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("cannot stat shared memory " + name);
+  }
+  length = static_cast<std::size_t>(info.st_size);
+  if (length < sizeof(ShmHeader)) {
+    close(fd);
+    throw std::runtime_error(name + " is not a controller server.");
+  }
+  void* address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    throw std::runtime_error("cannot map shared memory " + name);
+  }
+  segment = static_cast<ShmSegment*>(address);
+  const ShmHeader& header = segment->header;
+  bool valid = std::memcmp(header.magic, kShmMagic, sizeof(kShmMagic)) == 0;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (!valid || header.version != kShmVersion ||
+      length != segment_length(header.slot_count)) {
+    munmap(address, length);
+    throw std::runtime_error(name + " is not a controller server.");
+  }
+  if (slot >= header.slot_count) {
+    munmap(address, length);
+    throw std::out_of_range("slot index out of range.");
+  }
+  ShmSlot& mine = segment->slots()[slot];
+  uint32_t owner = 0;
+  const uint32_t me = static_cast<uint32_t>(getpid());
+  // A slot held by a client that exited without releasing it is taken over.
+  while (!mine.owner.compare_exchange_strong(owner, me)) {
+    if (process_exists(owner)) {
+      munmap(address, length);
+      throw std::runtime_error("slot is used by another client.");
+    }
+  }
+  // Outputs of a previous client's requests are not ours to receive.
+  submitted = mine.submitted.load(std::memory_order_relaxed);
+  received = submitted;
+}
+
+ShmControllerClient::~ShmControllerClient() {
+  segment->slots()[slot].owner.store(0, std::memory_order_release);
+  munmap(segment, length);
+}
+
+bool ShmControllerClient::submit(double setpoint_value,
+                                 double measured_value) {
+  ShmSlot& mine = segment->slots()[slot];
+  // After a takeover the server may still be reading the previous client's
+  // requests; their entries are only free once it has answered them.
+  const uint32_t done = mine.completed.load(std::memory_order_acquire);
+  if (submitted - received >= kShmRingCapacity ||
+      submitted - done >= kShmRingCapacity) {
+    return false;
+  }
+  ShmRequest& request = mine.requests[submitted & kRingMask];
+  request.setpoint = setpoint_value;
+  request.measured = measured_value;
+  ++submitted;
+  mine.submitted.store(submitted, std::memory_order_release);
+
+  ShmHeader& header = segment->header;
+  header.doorbell.fetch_add(1, std::memory_order_seq_cst);
+  if (header.server_sleeping.load(std::memory_order_seq_cst) != 0) {
+    futex_wake(&header.doorbell);
+  }
+  return true;
+}
+
+bool ShmControllerClient::try_receive(double* output) {
+  ShmSlot& mine = segment->slots()[slot];
+  // Signed difference: after a takeover, completed may still trail the
+  // requests of the previous client.
+  const uint32_t done = mine.completed.load(std::memory_order_acquire);
+  if (static_cast<int32_t>(done - received) <= 0) {
+    return false;
+  }
+  *output = mine.outputs[received & kRingMask];
+  ++received;
+  return true;
+}
+
+double ShmControllerClient::receive() {
+  if (received == submitted) {
+    throw std::logic_error("no request is outstanding.");
+  }
+  double output;
+  for (unsigned i = 0; i < spin; ++i) {
+    if (try_receive(&output)) {
+      return output;
+    }
+  }
+  ShmSlot& mine = segment->slots()[slot];
+  // Wake up now and then to notice a server that exited without stopping.
+  const struct timespec timeout = {0, 100000000};
+  while (true) {
+    mine.client_waiting.store(1, std::memory_order_seq_cst);
+    const uint32_t done = mine.completed.load(std::memory_order_seq_cst);
+    if (try_receive(&output)) {
+      mine.client_waiting.store(0, std::memory_order_relaxed);
+      return output;
+    }
+    if (!server_alive()) {
+      mine.client_waiting.store(0, std::memory_order_relaxed);
+      throw std::runtime_error("controller server stopped.");
+    }
+    futex_wait(&mine.completed, done, &timeout);
+  }
+}
+
+bool ShmControllerClient::server_alive() const {
+  const ShmHeader& header = segment->header;
+  return header.running.load(std::memory_order_acquire) != 0 &&
+         process_exists(header.server_pid.load(std::memory_order_acquire));
+}
+
+double ShmControllerClient::compute(double setpoint_value,
+                                    double measured_value) {
+  if (received != submitted) {
+    throw std::logic_error("earlier requests are still outstanding.");
+  }
+  if (!submit(setpoint_value, measured_value)) {
+    // Only after a takeover: wait for the server to answer the previous
+    // client's requests.
+    ShmSlot& mine = segment->slots()[slot];
+    const struct timespec timeout = {0, 100000000};
+    while (true) {
+      mine.client_waiting.store(1, std::memory_order_seq_cst);
+      const uint32_t done = mine.completed.load(std::memory_order_seq_cst);
+      if (submit(setpoint_value, measured_value)) {
+        mine.client_waiting.store(0, std::memory_order_relaxed);
+        break;
+      }
+      if (!server_alive()) {
+        mine.client_waiting.store(0, std::memory_order_relaxed);
+        throw std::runtime_error("controller server stopped.");
+      }
+      futex_wait(&mine.completed, done, &timeout);
+    }
+  }
+  return receive();
+}
+
+void ShmControllerClient::set_spin(unsigned iterations) {
+  spin = iterations;
+}
+
+std::size_t ShmControllerClient::get_slot_count() const {
+  return segment->header.slot_count;
+}
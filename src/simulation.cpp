@@ -0,0 +1,281 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <simulation.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <parallel.hpp>
+#include <pid_bank.hpp>
+
+namespace {
+
+const std::size_t kNever = std::numeric_limits<std::size_t>::max();
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+void check_options(const SimulationOptions& options) {
+  if (options.setpoint == 0) {
+    throw std::invalid_argument("setpoint should not be 0.");
+  }
+  if (options.settling_band <= 0 || options.divergence_limit <= 0) {
+    throw std::invalid_argument(
+        "settling_band and divergence_limit should be greater than 0.");
+  }
+}
+
+/**
+ * @brief Running step-response metrics, fed one plant output per tick
+ *
+ */
+class StepTracker {
+ public:
+  StepTracker(const SimulationOptions& options, double dt)
+      : setpoint(options.setpoint), band(options.settling_band),
+        limit(options.divergence_limit), dt(dt), rise_start(kNever),
+        rise_end(kNever), last_outside(kNever), samples(0), peak(0), iae(0),
+        ise(0), last(0), diverged(false) {
+  }
+
+  // Returns false once the response diverged; later calls are ignored.
+  bool observe(double y) {
+    if (diverged) {
+      return false;
+    }
+    const double normalized = y / setpoint;
+    if (!std::isfinite(normalized) || std::fabs(normalized) > limit) {
+      diverged = true;
+      last = y;
+      return false;
+    }
+    const std::size_t k = samples++;
+    if (rise_start == kNever && normalized >= 0.1) {
+      rise_start = k;
+    }
+    if (rise_end == kNever && normalized >= 0.9) {
+      rise_end = k;
+    }
+    if (std::fabs(normalized - 1) > band) {
+      last_outside = k;
+    }
+    peak = std::max(peak, normalized);
+    const double error = setpoint - y;
+    iae += std::fabs(error) * dt;
+    ise += error * error * dt;
+    last = y;
+    return true;
+  }
+
+  StepResponseMetrics finish() const {
+    StepResponseMetrics metrics;
+    metrics.rise_time = rise_end == kNever
+                            ? kInfinity
+                            : static_cast<double>(rise_end - rise_start) * dt;
+    metrics.overshoot = std::max(0.0, peak - 1) * 100;
+    metrics.settled = !diverged && samples > 0 &&
+                      (last_outside == kNever || last_outside + 1 < samples);
+    if (!metrics.settled) {
+      metrics.settling_time = kInfinity;
+    } else if (last_outside == kNever) {
+      metrics.settling_time = 0;
+    } else {
+      metrics.settling_time = static_cast<double>(last_outside + 1) * dt;
+    }
+    metrics.iae = diverged ? kInfinity : iae;
+    metrics.ise = diverged ? kInfinity : ise;
+    metrics.final_value = last;
+    metrics.diverged = diverged;
+    return metrics;
+  }
+
+ private:
+  double setpoint;
+  double band;
+  double limit;
+  double dt;
+  std::size_t rise_start;
+  std::size_t rise_end;
+  std::size_t last_outside;
+  std::size_t samples;
+  double peak;
+  double iae;
+  double ise;
+  double last;
+  bool diverged;
+};
+
+}  // namespace
+
+StepResponseMetrics simulate_step_response(PIDController* controller,
+                                           const PlantParams& plant,
+                                           const SimulationOptions& options,
+                                           std::vector<double>* trajectory) {
+  if (controller == nullptr) {
+    throw std::invalid_argument("controller should be set.");
+  }
+  DiscretePlant model(plant, controller->get_dt());
+  return simulate_step_response(controller, &model, options, trajectory);
+}
+
+StepResponseMetrics simulate_step_response(PIDController* controller,
+                                           DiscretePlant* plant,
+                                           const SimulationOptions& options,
+                                           std::vector<double>* trajectory) {
+  if (controller == nullptr || plant == nullptr) {
+    throw std::invalid_argument("controller and plant should be set.");
+  }
+  if (controller->get_dt() != plant->get_dt()) {
+    throw std::invalid_argument("controller and plant dt should match.");
+  }
+  check_options(options);
+  StepTracker tracker(options, controller->get_dt());
+  if (trajectory != nullptr) {
+    trajectory->clear();
+    trajectory->reserve(options.steps);
+  }
+
+  for (std::size_t k = 0; k < options.steps; ++k) {
+    const double y = plant->output();
+    if (trajectory != nullptr) {
+      trajectory->push_back(y);
+    }
+    if (!tracker.observe(y)) {
+      break;
+    }
+    plant->step(controller->compute(options.setpoint, y));
+  }
+  return tracker.finish();
+}
+
+std::size_t ClosedLoopSimulator::add(const GainSet& gain_set,
+                                     const PlantParams& plant) {
+  DiscretePlantModel model = discretize(plant, gain_set.dt);
+  gains.push_back(gain_set);
+  a11.push_back(model.a11);
+  a12.push_back(model.a12);
+  a21.push_back(model.a21);
+  a22.push_back(model.a22);
+  b1.push_back(model.b1);
+  b2.push_back(model.b2);
+  delay_samples.push_back(model.delay_samples);
+  return gains.size() - 1;
+}
+
+std::size_t ClosedLoopSimulator::size() const {
+  return gains.size();
+}
+
+std::vector<StepResponseMetrics> ClosedLoopSimulator::run(
+    const SimulationOptions& options, unsigned threads) {
+  check_options(options);
+  const std::size_t count = gains.size();
+  std::vector<StepResponseMetrics> metrics(count);
+  trajectories.clear();
+  if (options.record_trajectory) {
+    trajectories.resize(count);
+  }
+  const std::size_t chunks = (count + kChunkSize - 1) / kChunkSize;
+  parallel_for(chunks, threads, [&](std::size_t chunk) {
+    std::size_t begin = chunk * kChunkSize;
+    std::size_t end = std::min(count, begin + kChunkSize);
+    run_chunk(begin, end, options, &metrics[begin]);
+  });
+  return metrics;
+}
+
+const std::vector<double>& ClosedLoopSimulator::get_trajectory(
+    std::size_t index) const {
+  if (index >= gains.size()) {
+    throw std::out_of_range("simulation index out of range.");
+  }
+  if (trajectories.empty()) {
+    throw std::logic_error("trajectories were not recorded.");
+  }
+  return trajectories[index];
+}
+
+void ClosedLoopSimulator::run_chunk(std::size_t begin, std::size_t end,
+                                    const SimulationOptions& options,
+                                    StepResponseMetrics* metrics) {
+  const std::size_t n = end - begin;
+  PIDControllerBank bank(n);
+  std::vector<StepTracker> trackers;
+  trackers.reserve(n);
+  std::vector<std::size_t> delay_offset(n + 1, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    const GainSet& g = gains[begin + i];
+    bank.add(g.kP, g.kI, g.kD, g.max_value, g.min_value, g.dt);
+    trackers.push_back(StepTracker(options, g.dt));
+    delay_offset[i + 1] = delay_offset[i] + delay_samples[begin + i];
+    if (options.record_trajectory) {
+      trajectories[begin + i].reserve(options.steps);
+    }
+  }
+
+  const double* A11 = &a11[begin];
+  const double* A12 = &a12[begin];
+  const double* A21 = &a21[begin];
+  const double* A22 = &a22[begin];
+  const double* B1 = &b1[begin];
+  const double* B2 = &b2[begin];
+
+  std::vector<double> setpoints(n, options.setpoint);
+  std::vector<double> x1(n, 0.0), x2(n, 0.0), measured(n), outputs(n);
+  std::vector<double> delay_line(delay_offset[n], 0.0);
+  std::vector<std::size_t> delay_head(n, 0);
+  std::vector<bool> active(n, true);
+  std::size_t active_count = n;
+
+  for (std::size_t k = 0; k < options.steps && active_count > 0; ++k) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!active[i]) {
+        // Hold a diverged run at zero error while the others continue.
+        measured[i] = options.setpoint;
+        continue;
+      }
+      measured[i] = x1[i];
+      if (options.record_trajectory) {
+        trajectories[begin + i].push_back(x1[i]);
+      }
+      if (!trackers[i].observe(x1[i])) {
+        active[i] = false;
+        --active_count;
+        measured[i] = options.setpoint;
+      }
+    }
+
+    bank.compute(setpoints.data(), measured.data(), outputs.data(), n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!active[i]) {
+        continue;
+      }
+      double u = outputs[i];
+      const std::size_t length = delay_offset[i + 1] - delay_offset[i];
+      if (length > 0) {
+        double* line = &delay_line[delay_offset[i]];
+        u = line[delay_head[i]];
+        line[delay_head[i]] = outputs[i];
+        delay_head[i] = delay_head[i] + 1 == length ? 0 : delay_head[i] + 1;
+      }
+      const double next1 = A11[i] * x1[i] + A12[i] * x2[i] + B1[i] * u;
+      const double next2 = A21[i] * x1[i] + A22[i] * x2[i] + B2[i] * u;
+      x1[i] = next1;
+      x2[i] = next2;
+    }
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    metrics[i] = trackers[i].finish();
+  }
+}
@@ -0,0 +1,306 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <snapshot.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char kSnapshotMagic[8] = {'P', 'I', 'D', 'S', 'N', 'A', 'P', 'S'};
+
+static_assert(sizeof(SnapshotHeader) == 64,
+              "SnapshotHeader should fill one cache line.");
+static_assert(sizeof(SnapshotRecord) == 64,
+              "SnapshotRecord should fill one cache line.");
+
+SnapshotRecord to_record(const PIDController& controller) {
+  SnapshotRecord record;
+  record.kP = controller.get_kP();
+  record.kI = controller.get_kI();
+  record.kD = controller.get_kD();
+  record.max_value = controller.get_max_value();
+  record.min_value = controller.get_min_value();
+  record.dt = controller.get_dt();
+  record.integral_sum = controller.get_integral_sum();
+  record.prev_error = controller.get_prev_error();
+  return record;
+}
+
+void from_record(const SnapshotRecord& record, PIDController* controller) {
+  controller->set_dt(record.dt);
+  controller->set_kP(record.kP);
+  controller->set_kI(record.kI);
+  controller->set_kD(record.kD);
+  controller->set_max_value(record.max_value);
+  controller->set_min_value(record.min_value);
+  controller->set_state(record.integral_sum, record.prev_error);
+}
+
+}  // namespace
+
+constexpr uint32_t ControllerSnapshot::kVersion;
+
+ControllerSnapshot::ControllerSnapshot(const std::string& path,
+                                       std::size_t count)
+    :
+    address(nullptr),
+    length(sizeof(SnapshotHeader) + count * sizeof(SnapshotRecord)),
+    header(nullptr),
+    records(nullptr),
+    interval(1),
+    countdown(1) {
+  if (count == 0) {
+    throw std::invalid_argument("count should be greater than 0.");
+  }
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("cannot create " + path);
+  }
+  if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+    close(fd);
+    throw std::runtime_error("cannot resize " + path);
+  }
+  map(fd, path);
+  std::memcpy(header->magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+  header->version = kVersion;
+  header->record_size = sizeof(SnapshotRecord);
+  header->count = count;
+  header->sequence = 0;
+}
+
+ControllerSnapshot::ControllerSnapshot(const std::string& path)
+    :
+    address(nullptr),
+    length(0),
+    header(nullptr),
+    records(nullptr),
+    interval(1),
+    countdown(1) {
+  int fd = open(path.c_str(), O_RDWR);
+  if (fd < 0) {
+    throw std::runtime_error("cannot open " + path);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("cannot stat " + path);
+  }
+  length = static_cast<std::size_t>(info.st_size);
+  if (length < sizeof(SnapshotHeader)) {
+    close(fd);
+    throw std::runtime_error(path + " is not a controller snapshot.");
+  }
+  map(fd, path);
+  const uint64_t expected_length =
+      sizeof(SnapshotHeader) + header->count * sizeof(SnapshotRecord);
+  if (std::memcmp(header->magic, kSnapshotMagic, sizeof(kSnapshotMagic)) ||
+      header->record_size != sizeof(SnapshotRecord) ||
+      header->count == 0 || length != expected_length) {
+    munmap(address, length);
+    throw std::runtime_error(path + " is not a controller snapshot.");
+  }
+  if (header->version != kVersion) {
+    munmap(address, length);
+    throw std::runtime_error(path + " has an unsupported snapshot version.");
+  }
+}
+
+ControllerSnapshot::~ControllerSnapshot() {
+  munmap(address, length);
+}
+
+void ControllerSnapshot::map(int fd, const std::string& path) {
+  address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    throw std::runtime_error("cannot map " + path);
+  }
+  header = static_cast<SnapshotHeader*>(address);
+  records = reinterpret_cast<SnapshotRecord*>(header + 1);
+}
+
+std::size_t ControllerSnapshot::size() const {
+  return static_cast<std::size_t>(header->count);
+}
+
+uint64_t ControllerSnapshot::get_save_count() const {
+  return __atomic_load_n(&header->sequence, __ATOMIC_ACQUIRE) / 2;
+}
+
+bool ControllerSnapshot::is_complete() const {
+  uint64_t sequence = __atomic_load_n(&header->sequence, __ATOMIC_ACQUIRE);
+  return sequence != 0 && (sequence & 1) == 0;
+}
+
+const SnapshotRecord& ControllerSnapshot::get_record(
+    std::size_t index) const {
+  check_index(index);
+  return records[index];
+}
+
+void ControllerSnapshot::check_index(std::size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("controller index out of range.");
+  }
+}
+
+void ControllerSnapshot::check_count(std::size_t count) const {
+  if (count != size()) {
+    throw std::invalid_argument(
+        "controller count does not match the snapshot.");
+  }
+}
+
+void ControllerSnapshot::check_complete() const {
+  if (!is_complete()) {
+    throw std::runtime_error(
+        "snapshot was never saved or a save was interrupted.");
+  }
+}
+
+// The sequence is odd while records are being written, so a process that
+// dies mid-save leaves a snapshot that is_complete() rejects. Forcing it odd
+// here, rather than adding one, lets the next whole-set save recover such a
+// file; save(index, ...) never calls this on an incomplete one.
+void ControllerSnapshot::begin_save() {
+  __atomic_store_n(&header->sequence, (header->sequence + 1) | 1,
+                   __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void ControllerSnapshot::end_save() {
+  __atomic_store_n(&header->sequence, header->sequence + 1,
+                   __ATOMIC_RELEASE);
+}
+
+void ControllerSnapshot::save(std::size_t index,
+                              const PIDController& controller) {
+  check_index(index);
+  // One record cannot vouch for the others: a file that was never saved
+  // in full, or whose last save was interrupted, stays incomplete.
+  if (!is_complete()) {
+    records[index] = to_record(controller);
+    return;
+  }
+  begin_save();
+  records[index] = to_record(controller);
+  end_save();
+}
+
+void ControllerSnapshot::save(const PIDController* controllers,
+                              std::size_t count) {
+  check_count(count);
+  begin_save();
+  for (std::size_t i = 0; i < count; ++i) {
+    records[i] = to_record(controllers[i]);
+  }
+  end_save();
+}
+
+void ControllerSnapshot::save(const PIDControllerBank& bank) {
+  const std::size_t count = bank.size();
+  check_count(count);
+  begin_save();
+  for (std::size_t i = 0; i < count; ++i) {
+    SnapshotRecord& record = records[i];
+    record.kP = bank.get_kP(i);
+    record.kI = bank.get_kI(i);
+    record.kD = bank.get_kD(i);
+    record.max_value = bank.get_max_value(i);
+    record.min_value = bank.get_min_value(i);
+    record.dt = bank.get_dt(i);
+    record.integral_sum = bank.get_integral_sum(i);
+    record.prev_error = bank.get_prev_error(i);
+  }
+  end_save();
+}
+
+void ControllerSnapshot::set_interval(unsigned ticks) {
+  if (ticks == 0) {
+    throw std::invalid_argument("interval should be greater than 0.");
+  }
+  interval = ticks;
+  countdown = 1;
+}
+
+bool ControllerSnapshot::tick(const PIDController* controllers,
+                              std::size_t count) {
+  if (--countdown != 0) {
+    return false;
+  }
+  countdown = interval;
+  save(controllers, count);
+  return true;
+}
+
+bool ControllerSnapshot::tick(const PIDControllerBank& bank) {
+  if (--countdown != 0) {
+    return false;
+  }
+  countdown = interval;
+  save(bank);
+  return true;
+}
+
+void ControllerSnapshot::restore(std::size_t index,
+                                 PIDController* controller) const {
+  check_index(index);
+  check_complete();
+  from_record(records[index], controller);
+}
+
+void ControllerSnapshot::restore(PIDController* controllers,
+                                 std::size_t count) const {
+  check_count(count);
+  check_complete();
+  for (std::size_t i = 0; i < count; ++i) {
+    from_record(records[i], &controllers[i]);
+  }
+}
+
+void ControllerSnapshot::restore(PIDControllerBank* bank) const {
+  check_complete();
+  const std::size_t count = size();
+  if (bank->size() == 0) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const SnapshotRecord& record = records[i];
+      bank->add(record.kP, record.kI, record.kD, record.max_value,
+                record.min_value, record.dt);
+    }
+  } else {
+    check_count(bank->size());
+    for (std::size_t i = 0; i < count; ++i) {
+      const SnapshotRecord& record = records[i];
+      bank->set_dt(i, record.dt);
+      bank->set_kP(i, record.kP);
+      bank->set_kI(i, record.kI);
+      bank->set_kD(i, record.kD);
+      bank->set_max_value(i, record.max_value);
+      bank->set_min_value(i, record.min_value);
+    }
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    bank->set_state(i, records[i].integral_sum, records[i].prev_error);
+  }
+}
+
+void ControllerSnapshot::flush() {
+  if (msync(address, length, MS_SYNC) != 0) {
+    throw std::runtime_error("cannot write the snapshot back.");
+  }
+}
@@ -0,0 +1,102 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <telemetry.hpp>
+
+#include <stdexcept>
+
+namespace {
+const std::size_t kDrainBatchSize = 256;
+}  // namespace
+
+TelemetryDrainer::TelemetryDrainer(TelemetryRingBuffer* buffer,
+                                   std::ostream* out, TelemetryFormat format,
+                                   std::chrono::microseconds poll_interval)
+    :
+    buffer(buffer),
+    out(out),
+    format(format),
+    poll_interval(poll_interval),
+    header_written(false),
+    batch(kDrainBatchSize),
+    running(false),
+    records_written(0) {
+  if (buffer == nullptr || out == nullptr) {
+    throw std::invalid_argument("buffer and out should not be null.");
+  }
+}
+
+TelemetryDrainer::~TelemetryDrainer() {
+  stop();
+}
+
+void TelemetryDrainer::start() {
+  if (running.exchange(true)) {
+    return;
+  }
+  worker = std::thread(&TelemetryDrainer::run, this);
+}
+
+void TelemetryDrainer::stop() {
+  running.store(false);
+  if (worker.joinable()) {
+    worker.join();
+  }
+  drain();
+  out->flush();
+}
+
+std::size_t TelemetryDrainer::drain() {
+  std::size_t total = 0;
+  std::size_t count;
+  while ((count = buffer->pop_batch(batch.data(), batch.size())) > 0) {
+    write_records(batch.data(), count);
+    total += count;
+  }
+  return total;
+}
+
+uint64_t TelemetryDrainer::get_records_written() const {
+  return records_written.load();
+}
+
+void TelemetryDrainer::write_records(const TelemetryRecord* records,
+                                     std::size_t count) {
+  if (format == TelemetryFormat::binary) {
+    out->write(reinterpret_cast<const char*>(records),
+               static_cast<std::streamsize>(count * sizeof(TelemetryRecord)));
+  } else {
+    if (!header_written) {
+      *out << "timestamp_ns,setpoint,measured,error,proportional,integral,"
+           << "derivative,output,saturated\n";
+      header_written = true;
+    }
+    // Enough digits for every double to read back exactly, like the trace
+    // replay output; the caller's precision is restored afterwards.
+    const std::streamsize precision = out->precision(17);
+    for (std::size_t i = 0; i < count; ++i) {
+      const TelemetryRecord& r = records[i];
+      *out << r.timestamp_ns << ',' << r.setpoint << ',' << r.measured << ','
+           << r.error << ',' << r.proportional << ',' << r.integral << ','
+           << r.derivative << ',' << r.output << ',' << r.saturated << '\n';
+    }
+    out->precision(precision);
+  }
+  records_written.fetch_add(count);
+}
+
+void TelemetryDrainer::run() {
+  while (running.load()) {
+    if (drain() == 0) {
+      std::this_thread::sleep_for(poll_interval);
+    }
+  }
+}
@@ -0,0 +1,318 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <trace_replay.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <mapped_file.hpp>
+#include <parallel.hpp>
+#include <pid.hpp>
+#include <pid_bank.hpp>
+
+namespace {
+
+const char kTraceMagic[8] = {'P', 'I', 'D', 'T', 'R', 'A', 'C', 'E'};
+const char kOutputMagic[8] = {'P', 'I', 'D', 'O', 'U', 'T', 'P', 'T'};
+const uint32_t kTraceVersion = 1;
+const std::size_t kWriteBufferSize = 1 << 20;
+const std::size_t kMaxNumberLength = 63;
+
+TraceHeader make_header(const char* magic, uint32_t columns) {
+  TraceHeader header;
+  std::memcpy(header.magic, magic, sizeof(header.magic));
+  header.version = kTraceVersion;
+  header.columns = columns;
+  return header;
+}
+
+/**
+ * @brief Buffered writer for replay outputs
+ *
+ */
+class OutputWriter {
+ public:
+  OutputWriter(const std::string& path, TraceFormat format,
+               std::size_t columns)
+      : path(path), format(format), columns(columns),
+        buffer(kWriteBufferSize) {
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+      throw std::runtime_error("cannot create " + path);
+    }
+    std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+    if (format == TraceFormat::binary) {
+      TraceHeader header = make_header(kOutputMagic,
+                                       static_cast<uint32_t>(columns + 1));
+      std::fwrite(&header, sizeof(header), 1, file);
+    } else {
+      std::fputs("timestamp", file);
+      for (std::size_t i = 0; i < columns; ++i) {
+        std::fprintf(file, ",output_%zu", i);
+      }
+      std::fputc('\n', file);
+    }
+  }
+
+  ~OutputWriter() {
+    if (file != nullptr) {
+      std::fclose(file);
+    }
+  }
+
+  void write_row(double timestamp, const double* outputs) {
+    if (format == TraceFormat::binary) {
+      std::fwrite(&timestamp, sizeof(double), 1, file);
+      std::fwrite(outputs, sizeof(double), columns, file);
+    } else {
+      std::fprintf(file, "%.17g", timestamp);
+      for (std::size_t i = 0; i < columns; ++i) {
+        std::fprintf(file, ",%.17g", outputs[i]);
+      }
+      std::fputc('\n', file);
+    }
+  }
+
+  void finish() {
+    bool failed = std::ferror(file) != 0;
+    failed = std::fclose(file) != 0 || failed;
+    file = nullptr;
+    if (failed) {
+      throw std::runtime_error("cannot write " + path);
+    }
+  }
+
+ private:
+  std::string path;
+  TraceFormat format;
+  std::size_t columns;
+  std::vector<char> buffer;
+  std::FILE* file;
+};
+
+// Parses one number of a csv field in [begin, end).
+bool parse_number(const char* begin, const char* end, double* value) {
+  while (begin < end && (*begin == ' ' || *begin == '\t')) {
+    ++begin;
+  }
+  while (end > begin && (end[-1] == ' ' || end[-1] == '\t' ||
+                         end[-1] == '\r')) {
+    --end;
+  }
+  std::size_t length = static_cast<std::size_t>(end - begin);
+  if (length == 0 || length > kMaxNumberLength) {
+    return false;
+  }
+  char text[kMaxNumberLength + 1];
+  std::memcpy(text, begin, length);
+  text[length] = '\0';
+  char* parsed_end = nullptr;
+  *value = std::strtod(text, &parsed_end);
+  return parsed_end == text + length;
+}
+
+// Calls visit(sample) for every sample of a mapped trace, in order.
+template <typename Visitor>
+uint64_t for_each_sample(const MappedFile& file, const std::string& path,
+                         Visitor visit) {
+  const char* data = file.data();
+  const std::size_t size = file.size();
+
+  if (size >= sizeof(TraceHeader) &&
+      std::memcmp(data, kTraceMagic, sizeof(kTraceMagic)) == 0) {
+    TraceHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    std::size_t payload = size - sizeof(TraceHeader);
+    if (header.version != kTraceVersion || header.columns != 3 ||
+        payload % sizeof(TraceSample) != 0) {
+      throw std::runtime_error("malformed binary trace " + path);
+    }
+    // The mapping is page aligned and the header is 16 bytes, so the
+    // records can be read in place.
+    const TraceSample* samples =
+        reinterpret_cast<const TraceSample*>(data + sizeof(TraceHeader));
+    const std::size_t count = payload / sizeof(TraceSample);
+    for (std::size_t i = 0; i < count; ++i) {
+      visit(samples[i]);
+    }
+    return count;
+  }
+
+  uint64_t count = 0;
+  uint64_t line_number = 0;
+  const char* line = data;
+  const char* end = data + size;
+  while (line < end) {
+    const char* line_end = static_cast<const char*>(
+        std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+    if (line_end == nullptr) {
+      line_end = end;
+    }
+    ++line_number;
+
+    const char* fields[3] = {line, nullptr, nullptr};
+    int commas = 0;
+    for (const char* p = line; p < line_end; ++p) {
+      if (*p == ',') {
+        if (++commas > 2) {
+          break;
+        }
+        fields[commas] = p + 1;
+      }
+    }
+    bool blank = line_end == line || (line_end - line == 1 && *line == '\r');
+    if (!blank) {
+      TraceSample sample;
+      bool ok = commas == 2 &&
+                parse_number(fields[0], fields[1] - 1, &sample.timestamp) &&
+                parse_number(fields[1], fields[2] - 1, &sample.setpoint) &&
+                parse_number(fields[2], line_end, &sample.measured);
+      if (ok) {
+        visit(sample);
+        ++count;
+      } else if (line_number != 1) {
+        // Only the first line may be a column header.
+        throw std::runtime_error("malformed csv trace " + path + " line " +
+                                 std::to_string(line_number));
+      }
+    }
+    line = line_end + 1;
+  }
+  return count;
+}
+
+}  // namespace
+
+void write_binary_trace(const std::string& path,
+                        const std::vector<TraceSample>& samples) {
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    throw std::runtime_error("cannot create " + path);
+  }
+  TraceHeader header = make_header(kTraceMagic, 3);
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+  if (!samples.empty()) {
+    ok = ok && std::fwrite(samples.data(), sizeof(TraceSample),
+                           samples.size(), file) == samples.size();
+  }
+  ok = std::fclose(file) == 0 && ok;
+  if (!ok) {
+    throw std::runtime_error("cannot write " + path);
+  }
+}
+
+std::vector<TraceSample> read_trace(const std::string& path) {
+  MappedFile input(path);
+  std::vector<TraceSample> samples;
+  for_each_sample(input, path, [&](const TraceSample& sample) {
+    samples.push_back(sample);
+  });
+  return samples;
+}
+
+TraceReplayer::TraceReplayer(const std::vector<GainSet>& gain_sets)
+    :
+    gain_sets(gain_sets) {
+  if (gain_sets.empty()) {
+    throw std::invalid_argument("at least one gain set is required.");
+  }
+  for (const GainSet& gains : gain_sets) {
+    if (gains.dt <= 0) {
+      throw std::invalid_argument("dt should be greater than 0.");
+    }
+  }
+}
+
+uint64_t TraceReplayer::replay(const std::string& input_path,
+                               const std::string& output_path,
+                               TraceFormat output_format) const {
+  MappedFile input(input_path);
+  OutputWriter writer(output_path, output_format, gain_sets.size());
+  uint64_t count;
+  // The first sample has no predecessor and steps by the gain set's dt;
+  // every later one steps by the time since the previous sample.
+  bool first = true;
+  double last_timestamp = 0;
+  auto elapsed = [&](const TraceSample& sample) {
+    const double step = sample.timestamp - last_timestamp;
+    // Also rejects NaN timestamps.
+    if (!first && !(step > 0)) {
+      throw std::runtime_error("timestamps should increase in " +
+                               input_path);
+    }
+    last_timestamp = sample.timestamp;
+    return step;
+  };
+
+  if (gain_sets.size() == 1) {
+    const GainSet& g = gain_sets[0];
+    PIDController controller(g.kP, g.kI, g.kD, g.max_value, g.min_value,
+                             g.dt);
+    count = for_each_sample(input, input_path,
+                            [&](const TraceSample& sample) {
+      const double step = elapsed(sample);
+      double output = first ? controller.compute(sample.setpoint,
+                                                 sample.measured)
+                            : controller.compute_with_dt(sample.setpoint,
+                                                         sample.measured,
+                                                         step);
+      first = false;
+      writer.write_row(sample.timestamp, &output);
+    });
+  } else {
+    const std::size_t n = gain_sets.size();
+    PIDControllerBank bank(n);
+    for (const GainSet& g : gain_sets) {
+      bank.add(g.kP, g.kI, g.kD, g.max_value, g.min_value, g.dt);
+    }
+    std::vector<double> setpoints(n), measured(n), outputs(n);
+    double bank_dt = 0;
+    count = for_each_sample(input, input_path,
+                            [&](const TraceSample& sample) {
+      const double step = elapsed(sample);
+      // The bank has no per-call step; its dt only changes when the
+      // spacing of the samples does.
+      if (!first && step != bank_dt) {
+        for (std::size_t i = 0; i < n; ++i) {
+          bank.set_dt(i, step);
+        }
+        bank_dt = step;
+      }
+      first = false;
+      std::fill(setpoints.begin(), setpoints.end(), sample.setpoint);
+      std::fill(measured.begin(), measured.end(), sample.measured);
+      bank.compute(setpoints.data(), measured.data(), outputs.data(), n);
+      writer.write_row(sample.timestamp, outputs.data());
+    });
+  }
+
+  writer.finish();
+  return count;
+}
+
+std::vector<uint64_t> TraceReplayer::replay_all(
+    const std::vector<std::pair<std::string, std::string> >& jobs,
+    TraceFormat output_format, unsigned threads) const {
+  std::vector<uint64_t> counts(jobs.size(), 0);
+  parallel_for(jobs.size(), threads, [&](std::size_t i) {
+    counts[i] = replay(jobs[i].first, jobs[i].second, output_format);
+  });
+  return counts;
+}
+
+std::size_t TraceReplayer::get_gain_set_count() const {
+  return gain_sets.size();
+}
@@ -0,0 +1,156 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include <autotune.hpp>
+#include <pid.hpp>
+#include <plant.hpp>
+#include <simulation.hpp>
+
+namespace {
+
+// Records an open-loop step of the input from 0 to 1 at t = 0.1.
+std::vector<TraceSample> record_step_test(const PlantParams& params,
+                                          double dt) {
+  DiscretePlant plant(params, dt);
+  std::vector<TraceSample> samples;
+  for (int k = 0; k < 500; ++k) {
+    TraceSample sample;
+    sample.timestamp = k * dt;
+    sample.setpoint = k < 10 ? 0.0 : 1.0;
+    sample.measured = plant.output();
+    samples.push_back(sample);
+    plant.step(sample.setpoint);
+  }
+  return samples;
+}
+
+}  // namespace
+
+// To test that the relay experiment finds the ultimate point of a
+// first-order-plus-dead-time plant (Ku = 8.5, Pu = 0.74 s analytically)
+TEST(Autotune_Test, relay_finds_ultimate_point) {
+  RelayResult relay = relay_test(first_order_plant(1.0, 1.0, 0.2), 0.01);
+  ASSERT_TRUE(relay.oscillated);
+  EXPECT_NEAR(8.5, relay.ultimate_gain, 8.5 * 0.25);
+  EXPECT_NEAR(0.74, relay.ultimate_period, 0.74 * 0.25);
+}
+
+// To test the classic Ziegler-Nichols table
+TEST(Autotune_Test, ziegler_nichols_gains) {
+  GainSet gains = ziegler_nichols_gains(10.0, 2.0, 50.0, -50.0, 0.01);
+  EXPECT_DOUBLE_EQ(6.0, gains.kP);
+  EXPECT_DOUBLE_EQ(6.0, gains.kI);
+  EXPECT_DOUBLE_EQ(1.5, gains.kD);
+  EXPECT_DOUBLE_EQ(50.0, gains.max_value);
+  EXPECT_DOUBLE_EQ(0.01, gains.dt);
+  EXPECT_THROW(ziegler_nichols_gains(0.0, 2.0, 50.0, -50.0, 0.01),
+               std::invalid_argument);
+}
+
+// To test that a step test is fitted with the right gain and time scales
+TEST(Autotune_Test, fit_first_order_plant_from_step_test) {
+  PlantParams fitted =
+      fit_first_order_plant(record_step_test(first_order_plant(2.0, 0.5, 0.2),
+                                             0.01));
+  EXPECT_EQ(PlantType::first_order, fitted.type);
+  EXPECT_NEAR(2.0, fitted.gain, 0.02);
+  EXPECT_NEAR(0.5, fitted.time_constant, 0.025);
+  EXPECT_NEAR(0.2, fitted.dead_time, 0.03);
+
+  std::vector<TraceSample> flat(10);
+  for (std::size_t i = 0; i < flat.size(); ++i) {
+    flat[i].timestamp = 0.1 * static_cast<double>(i);
+    flat[i].setpoint = 1.0;
+    flat[i].measured = 0.0;
+  }
+  EXPECT_THROW(fit_first_order_plant(flat), std::invalid_argument);
+}
+
+// To test that tuning improves on the starting gains and does not depend on
+// the number of threads
+TEST(Autotune_Test, tune_gains_improves_on_ziegler_nichols) {
+  PlantParams plant = second_order_plant(1.0, 4.0, 0.3, 0.05);
+  TuningOptions options;
+  options.simulation.steps = 500;
+  options.starts = 4;
+  options.max_evaluations = 150;
+  options.threads = 1;
+  TuningResult serial = tune_gains(plant, 0.01, options);
+  options.threads = 4;
+  TuningResult parallel = tune_gains(plant, 0.01, options);
+
+  EXPECT_EQ(serial.gains.kP, parallel.gains.kP);
+  EXPECT_EQ(serial.gains.kI, parallel.gains.kI);
+  EXPECT_EQ(serial.gains.kD, parallel.gains.kD);
+  EXPECT_EQ(serial.evaluations, parallel.evaluations);
+
+  const GainSet& g = serial.initial_gains;
+  PIDController initial(g.kP, g.kI, g.kD, g.max_value, g.min_value, g.dt);
+  StepResponseMetrics start =
+      simulate_step_response(&initial, plant, options.simulation);
+  EXPECT_FALSE(serial.metrics.diverged);
+  EXPECT_TRUE(serial.metrics.settled);
+  EXPECT_LE(serial.cost, start.iae);
+  EXPECT_GT(serial.evaluations, 4u);
+  EXPECT_LE(serial.evaluations, 4u * 155u);
+}
+
+// To test tuning against a recorded step test
+TEST(Autotune_Test, tune_gains_from_trace) {
+  TuningOptions options;
+  options.starts = 2;
+  options.max_evaluations = 100;
+  TuningResult result = tune_gains(
+      record_step_test(first_order_plant(1.5, 0.3, 0.05), 0.01), 0.01,
+      options);
+  EXPECT_FALSE(result.metrics.diverged);
+  EXPECT_TRUE(result.metrics.settled);
+  EXPECT_GT(result.gains.kP, 0.0);
+}
+
+// To test that a reverse-acting plant gets the mirrored, negative gains of
+// the same plant with a positive gain
+TEST(Autotune_Test, negative_plant_gain_gives_negative_gains) {
+  TuningOptions options;
+  options.simulation.steps = 500;
+  options.starts = 2;
+  options.max_evaluations = 100;
+  TuningResult direct =
+      tune_gains(first_order_plant(2.0, 0.4, 0.05), 0.01, options);
+  TuningResult reverse =
+      tune_gains(first_order_plant(-2.0, 0.4, 0.05), 0.01, options);
+  EXPECT_FALSE(reverse.metrics.diverged);
+  EXPECT_TRUE(reverse.metrics.settled);
+  EXPECT_LT(reverse.gains.kP, 0.0);
+  EXPECT_LT(reverse.initial_gains.kP, 0.0);
+  EXPECT_EQ(-direct.gains.kP, reverse.gains.kP);
+  EXPECT_EQ(-direct.gains.kI, reverse.gains.kI);
+  EXPECT_EQ(-direct.gains.kD, reverse.gains.kD);
+  EXPECT_EQ(direct.cost, reverse.cost);
+}
+
+// To test that invalid settings are rejected
+TEST(Autotune_Test, invalid_options_throw) {
+  RelayOptions relay;
+  relay.amplitude = 0;
+  EXPECT_THROW(relay_test(first_order_plant(1.0, 1.0), 0.01, relay),
+               std::invalid_argument);
+  TuningOptions options;
+  options.starts = 0;
+  EXPECT_THROW(tune_gains(first_order_plant(1.0, 1.0), 0.01, options),
+               std::invalid_argument);
+  EXPECT_THROW(tune_gains(first_order_plant(1.0, 1.0), 0.0),
+               std::invalid_argument);
+}
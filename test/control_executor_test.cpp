@@ -0,0 +1,98 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <control_executor.hpp>
+#include <pid.hpp>
+
+// To test that every registered loop ticks at roughly its own rate and
+// that the statistics count the ticks delivered to the actuator
+TEST(ControlExecutor_Test, loops_tick_at_their_period) {
+  PIDController fast(0.1, 0.1, 0.1, 100.0, -100.0, 0.002);
+  PIDController slow(0.1, 0.1, 0.1, 100.0, -100.0, 0.01);
+  std::atomic<int> fast_count(0), slow_count(0);
+  std::atomic<double> last_output(0);
+
+  ControlExecutor executor(2);
+  std::size_t fast_loop = executor.add_loop(
+      &fast, []() { return 20.0; }, []() { return 10.0; },
+      [&fast_count, &last_output](double out) {
+        fast_count.fetch_add(1);
+        last_output.store(out);
+      });
+  std::size_t slow_loop = executor.add_loop(
+      &slow, []() { return 1.0; }, []() { return 0.0; },
+      [&slow_count](double) { slow_count.fetch_add(1); });
+  EXPECT_EQ(2u, executor.get_loop_count());
+
+  executor.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  executor.stop();
+
+  LoopStats fast_stats = executor.get_stats(fast_loop);
+  LoopStats slow_stats = executor.get_stats(slow_loop);
+  EXPECT_EQ(static_cast<uint64_t>(fast_count.load()), fast_stats.ticks);
+  EXPECT_EQ(static_cast<uint64_t>(slow_count.load()), slow_stats.ticks);
+  // Loose bounds: the test machine may be loaded.
+  EXPECT_GT(fast_stats.ticks, 20u);
+  EXPECT_LE(fast_stats.ticks, 101u);
+  EXPECT_GT(slow_stats.ticks, 5u);
+  EXPECT_LE(slow_stats.ticks, 21u);
+  EXPECT_GT(fast_stats.ticks, slow_stats.ticks);
+  EXPECT_GE(fast_stats.max_jitter_ns, fast_stats.mean_jitter_ns);
+  // P term 1.0 plus a growing I term.
+  EXPECT_GT(last_output.load(), 1.0);
+}
+
+// To test that a loop whose tick takes longer than its period reports
+// overruns and missed deadlines instead of bursting to catch up
+TEST(ControlExecutor_Test, slow_tick_reports_overruns) {
+  PIDController controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.001);
+  ControlExecutor executor(1);
+  std::size_t loop = executor.add_loop(
+      &controller, []() { return 1.0; },
+      []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        return 0.0;
+      },
+      [](double) {});
+
+  executor.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  executor.stop();
+
+  LoopStats stats = executor.get_stats(loop);
+  EXPECT_GT(stats.ticks, 0u);
+  EXPECT_EQ(stats.ticks, stats.overruns);
+  EXPECT_GE(stats.missed_deadlines, 2 * stats.overruns);
+}
+
+// To test that invalid configurations are rejected
+TEST(ControlExecutor_Test, invalid_usage_throws_exception) {
+  EXPECT_THROW(ControlExecutor(0), std::invalid_argument);
+
+  PIDController controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.01);
+  ControlExecutor executor(1);
+  EXPECT_THROW(executor.add_loop(nullptr, []() { return 0.0; },
+                                 []() { return 0.0; }, [](double) {}),
+               std::invalid_argument);
+  executor.start();
+  EXPECT_THROW(executor.add_loop(&controller, []() { return 0.0; },
+                                 []() { return 0.0; }, [](double) {}),
+               std::logic_error);
+  executor.stop();
+  EXPECT_THROW(executor.get_stats(0), std::out_of_range);
+}
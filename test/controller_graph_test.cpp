@@ -0,0 +1,146 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <controller_graph.hpp>
+#include <pid.hpp>
+
+namespace {
+
+GainSet make_gains(double kP, double kI, double kD, double limit, double dt) {
+  GainSet gains = {kP, kI, kD, limit, -limit, dt};
+  return gains;
+}
+
+double position(int k) {
+  return 0.01 * k + 0.3 * ((k * 5) % 7) / 7.0;
+}
+
+double velocity(int k) {
+  return 0.2 * ((k * 3) % 5) / 5.0;
+}
+
+}  // namespace
+
+// To test that a position/velocity cascade with feedforward and a limiter
+// matches hand-chained PIDControllers exactly, whatever the declaration order
+TEST(ControllerGraph_Test, cascade_matches_chained_controllers) {
+  ControllerGraph graph;
+  // Inner nodes are declared before the outer ones on purpose.
+  ControllerGraph::NodeId limiter = graph.add_limiter(-5.0, 5.0);
+  ControllerGraph::NodeId inner = graph.add_pid(make_gains(2.0, 0.5, 0.01,
+                                                           50.0, 0.01));
+  ControllerGraph::NodeId sum = graph.add_sum();
+  ControllerGraph::NodeId outer = graph.add_pid(make_gains(1.5, 0.1, 0.02,
+                                                           10.0, 0.01));
+  ControllerGraph::NodeId feedforward = graph.add_feedforward(0.5, 0.0, 0.01);
+  ControllerGraph::NodeId reference = graph.add_input();
+  ControllerGraph::NodeId measured_position = graph.add_input();
+  ControllerGraph::NodeId measured_velocity = graph.add_input();
+
+  graph.connect(reference, outer, ControllerGraph::Port::setpoint);
+  graph.connect(measured_position, outer, ControllerGraph::Port::measured);
+  graph.connect(reference, feedforward);
+  graph.connect(outer, sum);
+  graph.connect(feedforward, sum);
+  graph.connect(sum, inner, ControllerGraph::Port::setpoint);
+  graph.connect(measured_velocity, inner, ControllerGraph::Port::measured);
+  graph.connect(inner, limiter);
+  EXPECT_FALSE(graph.is_compiled());
+  graph.compile();
+  EXPECT_TRUE(graph.is_compiled());
+  EXPECT_EQ(8u, graph.get_node_count());
+
+  PIDController outer_pid(1.5, 0.1, 0.02, 10.0, -10.0, 0.01);
+  PIDController inner_pid(2.0, 0.5, 0.01, 50.0, -50.0, 0.01);
+  for (int k = 0; k < 300; ++k) {
+    double r = k < 150 ? 1.0 : -0.5;
+    graph.set_input(reference, r);
+    graph.set_input(measured_position, position(k));
+    graph.set_input(measured_velocity, velocity(k));
+    graph.tick();
+
+    double velocity_setpoint = outer_pid.compute(r, position(k)) + 0.5 * r;
+    double expected = std::min(
+        std::max(inner_pid.compute(velocity_setpoint, velocity(k)), -5.0),
+        5.0);
+    ASSERT_EQ(velocity_setpoint, graph.get_output(sum));
+    ASSERT_EQ(expected, graph.get_output(limiter));
+  }
+}
+
+// To test that a decimated outer loop runs every N ticks and holds between
+TEST(ControllerGraph_Test, decimated_outer_loop) {
+  ControllerGraph graph;
+  ControllerGraph::NodeId reference = graph.add_input();
+  ControllerGraph::NodeId measured = graph.add_input();
+  ControllerGraph::NodeId outer = graph.add_pid(make_gains(1.0, 1.0, 0.0,
+                                                           100.0, 0.04), 4);
+  ControllerGraph::NodeId gain = graph.add_gain(-2.0);
+  graph.connect(reference, outer, ControllerGraph::Port::setpoint);
+  graph.connect(measured, outer, ControllerGraph::Port::measured);
+  graph.connect(outer, gain);
+  graph.compile();
+  graph.set_input(reference, 1.0);
+
+  PIDController outer_pid(1.0, 1.0, 0.0, 100.0, -100.0, 0.04);
+  double held = 0;
+  for (int k = 0; k < 20; ++k) {
+    graph.set_input(measured, position(k));
+    graph.tick();
+    if (k % 4 == 0) {
+      held = outer_pid.compute(1.0, position(k));
+    }
+    EXPECT_EQ(held, graph.get_output(outer));
+    EXPECT_EQ(-2.0 * held, graph.get_output(gain));
+  }
+
+  graph.reset();
+  EXPECT_EQ(0.0, graph.get_output(outer));
+  EXPECT_EQ(1.0, graph.get_output(reference));
+}
+
+// To test that invalid graphs and misuse are rejected
+TEST(ControllerGraph_Test, invalid_graphs_throw) {
+  ControllerGraph graph;
+  ControllerGraph::NodeId input = graph.add_input();
+  ControllerGraph::NodeId a = graph.add_gain(1.0);
+  ControllerGraph::NodeId b = graph.add_sum();
+  ControllerGraph::NodeId pid = graph.add_pid(make_gains(1, 0, 0, 1, 0.1));
+
+  EXPECT_THROW(graph.tick(), std::logic_error);
+  EXPECT_THROW(graph.connect(a, input), std::invalid_argument);
+  EXPECT_THROW(graph.connect(a, pid), std::invalid_argument);
+  EXPECT_THROW(graph.connect(a, b, ControllerGraph::Port::measured),
+               std::invalid_argument);
+  EXPECT_THROW(graph.connect(a, 99), std::out_of_range);
+  EXPECT_THROW(graph.add_gain(1.0, 0), std::invalid_argument);
+  EXPECT_THROW(graph.add_limiter(1.0, -1.0), std::invalid_argument);
+  EXPECT_THROW(graph.add_pid(make_gains(1, 0, 0, 1, 0.0)),
+               std::invalid_argument);
+  EXPECT_THROW(graph.add_pid(make_gains(1, 0, 0, 1, std::nan(""))),
+               std::invalid_argument);
+
+  graph.connect(input, a);
+  graph.connect(a, b);
+  graph.connect(b, a);
+  EXPECT_THROW(graph.compile(), std::invalid_argument);
+  EXPECT_FALSE(graph.is_compiled());
+
+  ControllerGraph ok;
+  ControllerGraph::NodeId gain = ok.add_gain(1.0);
+  ok.compile();
+  EXPECT_THROW(ok.set_input(gain, 1.0), std::invalid_argument);
+}
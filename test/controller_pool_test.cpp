@@ -0,0 +1,196 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <controller_pool.hpp>
+#include <gain_update.hpp>
+#include <pid.hpp>
+
+#ifdef __GLIBC__
+// Count every heap allocation in the test binary. The definitions below
+// take precedence over the C library's, operator new included, and forward
+// to glibc's allocator.
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+}
+
+namespace {
+std::atomic<uint64_t> heap_allocations(0);
+}  // namespace
+
+extern "C" void* malloc(std::size_t size) noexcept {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size) noexcept {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, std::size_t size) noexcept {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(pointer, size);
+}
+#endif
+
+namespace {
+
+GainSet make_gains() {
+  GainSet gains = {0.1, 0.1, 0.1, 100.0, -100.0, 0.01};
+  return gains;
+}
+
+// Reserve a locked arena where the limits allow it, an unlocked one
+// otherwise.
+PIDStatus reserve(ControllerPool* pool, std::size_t capacity) {
+  PIDStatus status = pool->reserve(capacity, true);
+  if (status == PIDStatus::lock_failed) {
+    status = pool->reserve(capacity, false);
+  }
+  return status;
+}
+
+}  // namespace
+
+// To test that the try_ methods report errors instead of throwing and leave
+// the controller unchanged
+TEST(ControllerPool_Test, try_methods_return_status) {
+  PIDController controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.01);
+  EXPECT_EQ(PIDStatus::invalid_dt, controller.try_set_dt(0.0));
+  EXPECT_EQ(PIDStatus::invalid_dt, controller.try_set_dt(std::nan("")));
+  EXPECT_EQ(0.01, controller.get_dt());
+  EXPECT_EQ(PIDStatus::ok, controller.try_set_dt(0.02));
+  EXPECT_EQ(0.02, controller.get_dt());
+
+  GainSet gains = make_gains();
+  gains.kP = 5.0;
+  gains.dt = -1.0;
+  EXPECT_EQ(PIDStatus::invalid_dt, controller.try_set_gains(gains));
+  EXPECT_EQ(0.1, controller.get_kP());
+  EXPECT_EQ(PIDStatus::invalid_dt, PIDController::check_gains(gains));
+  gains.dt = std::nan("");
+  EXPECT_EQ(PIDStatus::invalid_dt, PIDController::check_gains(gains));
+  gains.dt = 0.01;
+  EXPECT_EQ(PIDStatus::ok, controller.try_set_gains(gains));
+  EXPECT_EQ(5.0, controller.get_kP());
+
+  PIDResult<double> result = controller.try_compute_with_dt(1.0, 0.0, 0.0);
+  EXPECT_FALSE(result.ok());
+  result = controller.try_compute_with_dt(1.0, 0.0, std::nan(""));
+  EXPECT_EQ(PIDStatus::invalid_dt, result.status);
+  EXPECT_EQ(0.0, controller.get_integral_sum());
+  PIDController expected(5.0, 0.1, 0.1, 100.0, -100.0, 0.01);
+  result = controller.try_compute_with_dt(1.0, 0.0, 0.05);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(expected.compute_with_dt(1.0, 0.0, 0.05), result.value);
+  EXPECT_STREQ("dt should be greater than 0.",
+               pid_status_string(PIDStatus::invalid_dt));
+}
+
+// To test creating, exhausting and destroying pooled controllers
+TEST(ControllerPool_Test, create_and_destroy) {
+  ControllerPool pool;
+  EXPECT_EQ(PIDStatus::pool_exhausted, pool.create(make_gains()).status);
+  EXPECT_EQ(PIDStatus::invalid_argument, pool.reserve(0, false));
+  ASSERT_EQ(PIDStatus::ok, reserve(&pool, 3));
+  EXPECT_EQ(3u, pool.capacity());
+
+  std::vector<PIDController*> controllers;
+  for (int i = 0; i < 3; ++i) {
+    PIDResult<PIDController*> created = pool.create(make_gains());
+    ASSERT_TRUE(created.ok());
+    controllers.push_back(created.value);
+  }
+  EXPECT_EQ(3u, pool.size());
+  EXPECT_EQ(PIDStatus::pool_exhausted, pool.create(make_gains()).status);
+  GainSet bad = make_gains();
+  bad.dt = 0;
+  EXPECT_EQ(PIDStatus::invalid_dt, pool.create(bad).status);
+  EXPECT_EQ(PIDStatus::in_use, pool.reserve(8, false));
+
+  PIDController expected(0.1, 0.1, 0.1, 100.0, -100.0, 0.01);
+  EXPECT_EQ(expected.compute(2.0, 1.0), controllers[1]->compute(2.0, 1.0));
+
+  PIDController outsider(0.1, 0.1, 0.1, 100.0, -100.0, 0.01);
+  EXPECT_EQ(PIDStatus::invalid_argument, pool.destroy(&outsider));
+  EXPECT_EQ(PIDStatus::ok, pool.destroy(controllers[1]));
+  EXPECT_EQ(PIDStatus::invalid_argument, pool.destroy(controllers[1]));
+  EXPECT_EQ(2u, pool.size());
+  // The freed slot is reused, freshly constructed.
+  PIDResult<PIDController*> reused = pool.create(make_gains());
+  ASSERT_TRUE(reused.ok());
+  EXPECT_EQ(controllers[1], reused.value);
+  EXPECT_EQ(0.0, reused.value->get_integral_sum());
+}
+
+#ifdef __GLIBC__
+// To test that creating, running and destroying thousands of pooled
+// controllers, including the error paths and gain updates, never
+// allocates once the pool is reserved
+TEST(ControllerPool_Test, steady_state_does_not_allocate) {
+  const std::size_t kCount = 4096;
+  ControllerPool pool;
+  ASSERT_EQ(PIDStatus::ok, reserve(&pool, kCount));
+  GainUpdateChannel channel;
+  std::vector<PIDController*> controllers(kCount);
+  GainSet gains = make_gains();
+  GainSet bad = make_gains();
+  bad.dt = 0;
+  uint64_t failures = 0;
+  double sum = 0;
+
+  const uint64_t before = heap_allocations.load();
+  for (int round = 0; round < 8; ++round) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      PIDResult<PIDController*> created = pool.create(gains);
+      failures += created.ok() ? 0 : 1;
+      controllers[i] = created.value;
+    }
+    failures += pool.create(gains).ok() ? 1 : 0;
+    failures += pool.create(bad).ok() ? 1 : 0;
+    gains.kP = 0.1 * (round + 1);
+    channel.publish(gains, true);
+    for (std::size_t i = 0; i < kCount; ++i) {
+      PIDController* controller = controllers[i];
+      controller->set_gain_channel(&channel);
+      for (int k = 0; k < 4; ++k) {
+        sum += controller->compute(1.0, 0.01 * k);
+      }
+      failures += controller->try_set_dt(-1.0) == PIDStatus::invalid_dt ? 0
+                                                                        : 1;
+      failures += controller->try_compute_with_dt(1.0, 0.5, 0.0).ok() ? 1
+                                                                     : 0;
+      sum += controller->try_compute_with_dt(1.0, 0.5, 0.02).value;
+    }
+    for (std::size_t i = 0; i < kCount; ++i) {
+      failures += pool.destroy(controllers[i]) == PIDStatus::ok ? 0 : 1;
+    }
+  }
+  const uint64_t after = heap_allocations.load();
+
+  EXPECT_EQ(0u, after - before);
+  EXPECT_EQ(0u, failures);
+  EXPECT_EQ(0u, pool.size());
+  EXPECT_NE(0.0, sum);
+  // The hook does see allocations.
+  std::vector<double> probe(1);
+  EXPECT_LT(after, heap_allocations.load());
+}
+#endif
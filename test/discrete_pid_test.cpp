@@ -0,0 +1,117 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include <discrete_pid.hpp>
+#include <pid.hpp>
+
+namespace {
+
+double measurement(int k) {
+  return 5.0 + 3.0 * ((k * 7) % 11) / 11.0;
+}
+
+}  // namespace
+
+// To test that the default configuration behaves like PIDController
+TEST(DiscretePIDController_Test, matches_pid_controller) {
+  std::unique_ptr<AbstractPIDController> discrete(
+      new DiscretePIDController(0.4, 0.3, 0.05, 100.0, -100.0, 0.1));
+  PIDController reference(0.4, 0.3, 0.05, 100.0, -100.0, 0.1);
+  for (int k = 0; k < 200; ++k) {
+    double setpoint = k < 100 ? 10.0 : 2.0;
+    EXPECT_NEAR(reference.compute(setpoint, measurement(k)),
+                discrete->compute(setpoint, measurement(k)), 1e-9);
+  }
+  EXPECT_NEAR(reference.get_integral_sum(), discrete->get_integral_sum(),
+              1e-9);
+  EXPECT_EQ(reference.get_prev_error(), discrete->get_prev_error());
+}
+
+// To test that the velocity form gives the positional output when the output
+// stays inside the limits, also when switching forms mid-run
+TEST(DiscretePIDController_Test, velocity_form_matches_positional) {
+  DiscretePIDController positional(0.4, 0.3, 0.05, 100.0, -100.0, 0.1);
+  DiscretePIDController velocity(0.4, 0.3, 0.05, 100.0, -100.0, 0.1);
+  positional.set_derivative_filter(0.05);
+  velocity.set_derivative_filter(0.05);
+  velocity.set_form(PIDForm::velocity);
+  EXPECT_EQ(PIDForm::velocity, velocity.get_form());
+  for (int k = 0; k < 200; ++k) {
+    if (k == 150) {
+      velocity.set_form(PIDForm::positional);
+    }
+    EXPECT_NEAR(positional.compute(10.0, measurement(k)),
+                velocity.compute(10.0, measurement(k)), 1e-9);
+  }
+  EXPECT_NEAR(positional.get_integral_term(), velocity.get_integral_term(),
+              1e-9);
+}
+
+// To test that the derivative filter decays geometrically on a constant error
+TEST(DiscretePIDController_Test, derivative_filter_response) {
+  DiscretePIDController pid(0.0, 0.0, 1.0, 100.0, -100.0, 0.1);
+  pid.set_derivative_filter(0.4);
+  EXPECT_DOUBLE_EQ(0.4, pid.get_derivative_filter());
+  EXPECT_DOUBLE_EQ(2.0, pid.compute(1.0, 0.0));
+  EXPECT_DOUBLE_EQ(1.6, pid.compute(1.0, 0.0));
+  EXPECT_NEAR(1.28, pid.compute(1.0, 0.0), 1e-12);
+
+  // Coefficients follow the setters on the next tick.
+  pid.reset();
+  pid.set_derivative_filter(0.0);
+  pid.set_kD(0.5);
+  EXPECT_DOUBLE_EQ(5.0, pid.compute(1.0, 0.0));
+  pid.set_dt(0.05);
+  EXPECT_DOUBLE_EQ(10.0, pid.compute(2.0, 0.0));
+}
+
+// To test that both anti-windup modes keep the integral bounded while the
+// output is saturated, and the loop leaves saturation immediately after
+TEST(DiscretePIDController_Test, anti_windup_bounds_integral) {
+  DiscretePIDController none(1.0, 1.0, 0.0, 1.0, -1.0, 0.1);
+  DiscretePIDController clamping(1.0, 1.0, 0.0, 1.0, -1.0, 0.1);
+  DiscretePIDController back(1.0, 1.0, 0.0, 1.0, -1.0, 0.1);
+  clamping.set_anti_windup(AntiWindupMode::clamping);
+  back.set_anti_windup(AntiWindupMode::back_calculation);
+  back.set_tracking_gain(5.0);
+  EXPECT_EQ(AntiWindupMode::back_calculation, back.get_anti_windup());
+  EXPECT_DOUBLE_EQ(5.0, back.get_tracking_gain());
+
+  for (int k = 0; k < 100; ++k) {
+    EXPECT_EQ(1.0, none.compute(10.0, 0.0));
+    EXPECT_EQ(1.0, clamping.compute(10.0, 0.0));
+    EXPECT_EQ(1.0, back.compute(10.0, 0.0));
+  }
+  EXPECT_NEAR(100.0, none.get_integral_term(), 1e-9);
+  EXPECT_EQ(0.0, clamping.get_integral_term());
+  EXPECT_LT(back.get_integral_term(), 0.0);
+
+  EXPECT_EQ(1.0, none.compute(0.0, 0.5));
+  EXPECT_LT(clamping.compute(0.0, 0.5), 0.0);
+  EXPECT_LT(back.compute(0.0, 0.5), 1.0);
+}
+
+// To test that invalid parameters are rejected
+TEST(DiscretePIDController_Test, invalid_parameters_throw) {
+  EXPECT_THROW(DiscretePIDController(1, 1, 1, 1, -1, 0.0),
+               std::invalid_argument);
+  DiscretePIDController pid(1, 1, 1, 1, -1, 0.1);
+  EXPECT_THROW(pid.set_dt(-0.1), std::invalid_argument);
+  EXPECT_THROW(pid.set_dt(std::nan("")), std::invalid_argument);
+  EXPECT_THROW(pid.set_derivative_filter(-1.0), std::invalid_argument);
+  EXPECT_THROW(pid.set_tracking_gain(-1.0), std::invalid_argument);
+  EXPECT_DOUBLE_EQ(0.1, pid.get_dt());
+}
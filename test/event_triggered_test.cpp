@@ -0,0 +1,135 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include <event_triggered.hpp>
+#include <pid.hpp>
+
+namespace {
+
+const double kDt = 1.0 / 128;
+
+GainSet make_gains() {
+  GainSet gains = {0.8, 0.4, 0.02, 50.0, -50.0, kDt};
+  return gains;
+}
+
+}  // namespace
+
+// To test that a steady signal is only recomputed every max_interval and
+// that the recompute matches a controller that computed every sample
+TEST(EventTriggered_Test, steady_signal_skips_until_max_interval) {
+  EventTriggeredController controller(make_gains(), 0.01, 16 * kDt);
+  PIDController expected(0.8, 0.4, 0.02, 50.0, -50.0, kDt);
+
+  EXPECT_TRUE(controller.update(0.0, 1.0, 0.5));
+  EXPECT_EQ(expected.compute(1.0, 0.5), controller.get_output());
+  for (int k = 1; k < 16; ++k) {
+    // Within the threshold of the last computed error.
+    double measured = 0.5 + 0.005 * (k % 2);
+    EXPECT_FALSE(controller.update(k * kDt, 1.0, measured));
+    expected.compute(1.0, measured);
+  }
+  EXPECT_TRUE(controller.update(16 * kDt, 1.0, 0.505));
+  EXPECT_NEAR(expected.compute(1.0, 0.505), controller.get_output(), 1e-12);
+  EXPECT_NEAR(expected.get_integral_sum(),
+              controller.get_controller().get_integral_sum(), 1e-12);
+  EXPECT_EQ(2u, controller.get_compute_count());
+  EXPECT_EQ(15u, controller.get_skip_count());
+}
+
+// To test that a step after a quiet period integrates the held samples
+// with their own error, not with the error of the step
+TEST(EventTriggered_Test, step_after_quiet_period_matches_per_sample) {
+  GainSet gains = {0.0, 1.0, 0.0, 1e6, -1e6, 0.01};
+  EventTriggeredController controller(gains, 0.1, 1.0);
+  PIDController expected(0.0, 1.0, 0.0, 1e6, -1e6, 0.01);
+  for (int k = 0; k < 50; ++k) {
+    controller.update(k * 0.01, 0.0, 0.0);
+    expected.compute(0.0, 0.0);
+  }
+  EXPECT_EQ(1u, controller.get_compute_count());
+  EXPECT_TRUE(controller.update(50 * 0.01, 10.0, 0.0));
+  EXPECT_NEAR(expected.compute(10.0, 0.0), controller.get_output(), 1e-12);
+  EXPECT_NEAR(0.1, controller.get_controller().get_integral_sum(), 1e-12);
+}
+
+// To test that an error change beyond the threshold triggers at once
+TEST(EventTriggered_Test, error_change_triggers_compute) {
+  EventTriggeredController controller(make_gains(), 0.1, 1.0);
+  PIDController expected(0.8, 0.4, 0.02, 50.0, -50.0, kDt);
+  controller.update(0.0, 1.0, 1.0);
+  expected.compute(1.0, 1.0);
+  EXPECT_FALSE(controller.update(kDt, 1.0, 0.95));
+  expected.compute(1.0, 0.95);
+  EXPECT_FALSE(controller.update(2 * kDt, 1.05, 1.0));
+  expected.compute(1.05, 1.0);
+  EXPECT_TRUE(controller.update(3 * kDt, 2.0, 1.0));
+  EXPECT_NEAR(expected.compute(2.0, 1.0), controller.get_output(), 1e-12);
+  // Timestamps that do not move forward never compute.
+  EXPECT_FALSE(controller.update(3 * kDt, 10.0, 0.0));
+
+  controller.reset();
+  EXPECT_EQ(0.0, controller.get_output());
+  EXPECT_TRUE(controller.update(4 * kDt, 1.0, 1.0));
+}
+
+// To test that a zero threshold and max_interval == dt reproduce
+// PIDController::compute() exactly
+TEST(EventTriggered_Test, degenerates_to_every_tick) {
+  EventTriggeredController controller(make_gains(), 0.0, kDt);
+  PIDController expected(0.8, 0.4, 0.02, 50.0, -50.0, kDt);
+  for (int k = 0; k < 300; ++k) {
+    double measured = 0.01 * (k % 37);
+    ASSERT_TRUE(controller.update(k * kDt, 1.0, measured));
+    ASSERT_EQ(expected.compute(1.0, measured), controller.get_output());
+  }
+}
+
+// To test that a batch reports only the controllers that changed
+TEST(EventTriggered_Test, batch_reports_changed_controllers) {
+  EventTriggeredBatch batch;
+  for (int i = 0; i < 4; ++i) {
+    batch.add(make_gains(), 0.05, 1.0);
+  }
+  std::vector<double> setpoints(4, 1.0), measured(4, 0.0), outputs(4, -1.0);
+  std::vector<std::size_t> changed(4);
+  EXPECT_EQ(4u, batch.update(0.0, setpoints.data(), measured.data(),
+                             outputs.data(), changed.data()));
+
+  measured[1] = 0.5;
+  measured[3] = 0.01;  // below the threshold
+  setpoints[2] = 3.0;
+  std::vector<double> before(outputs);
+  ASSERT_EQ(2u, batch.update(kDt, setpoints.data(), measured.data(),
+                             outputs.data(), changed.data()));
+  EXPECT_EQ(1u, changed[0]);
+  EXPECT_EQ(2u, changed[1]);
+  EXPECT_EQ(before[0], outputs[0]);
+  EXPECT_EQ(before[3], outputs[3]);
+  EXPECT_EQ(batch.get(1).get_output(), outputs[1]);
+  EXPECT_THROW(batch.get(4), std::out_of_range);
+}
+
+// To test the argument checks
+TEST(EventTriggered_Test, invalid_arguments_throw) {
+  GainSet gains = make_gains();
+  EXPECT_THROW(EventTriggeredController(gains, -1.0, 1.0),
+               std::invalid_argument);
+  EXPECT_THROW(EventTriggeredController(gains, 0.0, 0.0),
+               std::invalid_argument);
+  gains.dt = 0;
+  EXPECT_THROW(EventTriggeredController(gains, 0.0, 1.0),
+               std::invalid_argument);
+}
@@ -0,0 +1,59 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+#include <fixed_point.hpp>
+
+// To test conversions to and from double
+TEST(FixedPoint_Test, conversions_round_to_nearest) {
+  EXPECT_EQ(65536, Q16_16(1.0).get_raw());
+  EXPECT_EQ(-98304, Q16_16(-1.5).get_raw());
+  EXPECT_EQ(1, Q16_16(1.0 / 65536 * 0.6).get_raw());
+  EXPECT_EQ(0, Q16_16(std::nan("")).get_raw());
+  EXPECT_EQ(0.25, static_cast<double>(Q16_16(0.25)));
+  EXPECT_EQ(Q16_16::max(), Q16_16(1e9));
+  EXPECT_EQ(Q16_16::lowest(), Q16_16(-1e9));
+}
+
+// To test that the arithmetic saturates instead of wrapping
+TEST(FixedPoint_Test, arithmetic_saturates) {
+  Q16_16 big(30000.0);
+  EXPECT_EQ(Q16_16::max(), big + big);
+  EXPECT_EQ(Q16_16::lowest(), -big - big);
+  EXPECT_EQ(Q16_16::max(), big * big);
+  EXPECT_EQ(Q16_16::lowest(), big * -big);
+  EXPECT_EQ(Q16_16::max(), -Q16_16::lowest());
+  EXPECT_EQ(Q16_16::max(), Q16_16(1.0) / Q16_16(0.0));
+  EXPECT_EQ(Q16_16::lowest(), Q16_16(-1.0) / Q16_16(0.0));
+  EXPECT_EQ(Q16_16(), Q16_16() / Q16_16());
+}
+
+// To test the in-range arithmetic and comparisons
+TEST(FixedPoint_Test, arithmetic_in_range) {
+  Q16_16 a(2.5);
+  Q16_16 b(-0.75);
+  EXPECT_EQ(1.75, static_cast<double>(a + b));
+  EXPECT_EQ(3.25, static_cast<double>(a - b));
+  EXPECT_EQ(-1.875, static_cast<double>(a * b));
+  EXPECT_NEAR(-10.0 / 3, static_cast<double>(a / b), 0.5 / 65536);
+  EXPECT_NEAR(10.0 / 3, static_cast<double>(-a / b), 0.5 / 65536);
+  EXPECT_NEAR(-10.0 / 3, static_cast<double>(-a / -b), 0.5 / 65536);
+  EXPECT_TRUE(b < a);
+  EXPECT_TRUE(a >= a);
+  EXPECT_TRUE(a != b);
+  Q16_16 c = a;
+  c += b;
+  c *= Q16_16(2.0);
+  EXPECT_EQ(3.5, static_cast<double>(c));
+}
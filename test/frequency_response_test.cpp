@@ -0,0 +1,158 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include <frequency_response.hpp>
+#include <pid.hpp>
+#include <plant.hpp>
+#include <simulation.hpp>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+GainSet pi_gains(double scale) {
+  GainSet gains = {1.2 * scale, 2.0 * scale, 0.0, 1e9, -1e9, 0.01};
+  return gains;
+}
+
+// Runs a long step response and reports whether it diverged.
+bool diverges(const GainSet& gains, const PlantParams& plant) {
+  PIDController controller(gains.kP, gains.kI, gains.kD, gains.max_value,
+                           gains.min_value, gains.dt);
+  SimulationOptions options;
+  options.steps = 20000;
+  options.divergence_limit = 100.0;
+  return simulate_step_response(&controller, plant, options).diverged;
+}
+
+}  // namespace
+
+// To test the open loop against a direct complex evaluation of C(z) P(z)
+TEST(FrequencyResponse_Test, open_loop_matches_complex_reference) {
+  FrequencyOptions options;
+  options.points = 64;
+  FrequencyAnalyzer analyzer(options);
+  PIDController controller(1.5, 0.7, 0.05, 100.0, -100.0, 0.02);
+  PlantParams plant = second_order_plant(2.0, 4.0, 0.3, 0.06);
+  analyzer.add(controller, plant);
+  FrequencyResponse response = analyzer.get_response(0);
+  ASSERT_EQ(64u, response.frequency.size());
+  EXPECT_DOUBLE_EQ(kPi / 0.02, response.frequency.back());
+
+  DiscretePlantModel model = discretize(plant, 0.02);
+  for (std::size_t k = 0; k < 64; k += 9) {
+    const double theta = response.frequency[k] * 0.02;
+    const std::complex<double> z = std::polar(1.0, theta);
+    const std::complex<double> back = 1.0 - 1.0 / z;
+    const std::complex<double> pid =
+        1.5 + 0.7 * 0.02 / back + 0.05 / 0.02 * back;
+    const std::complex<double> pd =
+        ((z - model.a22) * model.b1 + model.a12 * model.b2) /
+        ((z - model.a11) * (z - model.a22) - model.a12 * model.a21) *
+        std::pow(z, -static_cast<double>(model.delay_samples));
+    const std::complex<double> loop = pid * pd;
+    EXPECT_NEAR(20 * std::log10(std::abs(loop)), response.open_gain[k],
+                1e-9);
+    EXPECT_NEAR(20 * std::log10(std::abs(loop / (1.0 + loop))),
+                response.closed_gain[k], 1e-9);
+    // Unwrapped, so only equal modulo a full turn.
+    const double turns =
+        (response.open_phase[k] - std::arg(loop) * 180 / kPi) / 360;
+    EXPECT_NEAR(std::round(turns), turns, 1e-9);
+  }
+}
+
+// To test that the gain margin predicts the gain at which the closed loop
+// loses stability in simulation
+TEST(FrequencyResponse_Test, gain_margin_matches_simulation) {
+  PlantParams plant = first_order_plant(1.0, 0.3, 0.1);
+  FrequencyAnalyzer analyzer;
+  analyzer.add(pi_gains(1.0), plant);
+  StabilityMargins margins = analyzer.analyze()[0];
+  ASSERT_TRUE(std::isfinite(margins.gain_margin));
+  ASSERT_GT(margins.gain_margin, 0.0);
+  EXPECT_GT(margins.phase_crossover, margins.gain_crossover);
+  EXPECT_GT(margins.phase_margin, 0.0);
+
+  const double limit = std::pow(10.0, margins.gain_margin / 20);
+  EXPECT_FALSE(diverges(pi_gains(0.95 * limit), plant));
+  EXPECT_TRUE(diverges(pi_gains(1.05 * limit), plant));
+}
+
+// To test that extra dead time leaves the gain crossover alone and takes
+// w_c * delay off the phase margin, and the bandwidth definition
+TEST(FrequencyResponse_Test, dead_time_reduces_phase_margin) {
+  FrequencyAnalyzer analyzer;
+  analyzer.add(pi_gains(1.0), first_order_plant(1.0, 0.3));
+  analyzer.add(pi_gains(1.0), first_order_plant(1.0, 0.3, 0.05));
+  std::vector<StabilityMargins> margins = analyzer.analyze();
+  EXPECT_NEAR(margins[0].gain_crossover, margins[1].gain_crossover, 1e-6);
+  EXPECT_NEAR(margins[0].phase_margin - margins[1].phase_margin,
+              margins[0].gain_crossover * 0.05 * 180 / kPi, 0.05);
+
+  FrequencyResponse response = analyzer.get_response(1);
+  const double band = response.closed_gain[0] - 3.0103;
+  std::size_t k = 0;
+  while (response.closed_gain[k] >= band) {
+    ++k;
+  }
+  EXPECT_LE(response.frequency[k - 1], margins[1].bandwidth);
+  EXPECT_GE(response.frequency[k], margins[1].bandwidth);
+}
+
+// To test a large batch, thread-count independence and missing crossovers
+TEST(FrequencyResponse_Test, batch_is_independent_of_threads) {
+  FrequencyOptions options;
+  options.points = 512;
+  FrequencyAnalyzer analyzer(options);
+  for (int i = 0; i < 2000; ++i) {
+    GainSet gains = pi_gains(0.2 + 0.001 * i);
+    gains.kD = 0.0001 * (i % 50);
+    analyzer.add(gains, second_order_plant(1.0, 5.0, 0.4, 0.01 * (i % 7)));
+  }
+  GainSet weak = {0.1, 0.0, 0.0, 1.0, -1.0, 0.01};
+  analyzer.add(weak, first_order_plant(1.0, 0.3));
+  EXPECT_EQ(2001u, analyzer.size());
+
+  std::vector<StabilityMargins> serial = analyzer.analyze(1);
+  std::vector<StabilityMargins> parallel = analyzer.analyze(4);
+  for (std::size_t i = 0; i < serial.size(); ++i) {
+    ASSERT_EQ(serial[i].gain_margin, parallel[i].gain_margin);
+    ASSERT_EQ(serial[i].phase_margin, parallel[i].phase_margin);
+    ASSERT_EQ(serial[i].bandwidth, parallel[i].bandwidth);
+  }
+  // |L| stays below 1, so there is no gain crossover.
+  EXPECT_TRUE(std::isinf(serial.back().phase_margin));
+  EXPECT_TRUE(std::isinf(serial.back().gain_crossover));
+}
+
+// To test the argument checks
+TEST(FrequencyResponse_Test, invalid_arguments_throw) {
+  FrequencyOptions options;
+  options.points = 1;
+  EXPECT_THROW(FrequencyAnalyzer{options}, std::invalid_argument);
+  options.points = 16;
+  options.decades = 0;
+  EXPECT_THROW(FrequencyAnalyzer{options}, std::invalid_argument);
+
+  FrequencyAnalyzer analyzer;
+  EXPECT_THROW(analyzer.add(pi_gains(1.0), first_order_plant(1.0, 0.0)),
+               std::invalid_argument);
+  EXPECT_EQ(0u, analyzer.size());
+  EXPECT_TRUE(analyzer.analyze().empty());
+  EXPECT_THROW(analyzer.get_response(0), std::out_of_range);
+}
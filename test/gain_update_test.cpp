@@ -0,0 +1,135 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#include <gain_update.hpp>
+#include <pid.hpp>
+#include <seqlock.hpp>
+
+namespace {
+
+GainSet make_gains(double kP, double kI, double kD) {
+  GainSet gains;
+  gains.kP = kP;
+  gains.kI = kI;
+  gains.kD = kD;
+  gains.max_value = 100.0;
+  gains.min_value = -100.0;
+  gains.dt = 0.1;
+  return gains;
+}
+
+}  // namespace
+
+// To test that nothing is read before the first publish and that the
+// version advances with every publish
+TEST(GainUpdateChannel_Test, poll_returns_only_new_versions) {
+  GainUpdateChannel channel;
+  uint64_t version = 0;
+  GainUpdate update;
+  EXPECT_FALSE(channel.poll(&version, &update));
+
+  channel.publish(make_gains(1, 2, 3));
+  ASSERT_TRUE(channel.poll(&version, &update));
+  EXPECT_EQ(1u, version);
+  EXPECT_EQ(2.0, update.gains.kI);
+  EXPECT_FALSE(update.bumpless);
+  EXPECT_FALSE(channel.poll(&version, &update));
+
+  channel.publish(make_gains(4, 5, 6), true);
+  ASSERT_TRUE(channel.poll(&version, &update));
+  EXPECT_EQ(2u, version);
+  EXPECT_TRUE(update.bumpless);
+}
+
+// To test that a gain set with invalid dt is rejected on the tuning side
+TEST(GainUpdateChannel_Test, publish_invalid_dt_throws_exception) {
+  GainUpdateChannel channel;
+  GainSet gains = make_gains(1, 1, 1);
+  gains.dt = 0;
+  EXPECT_THROW(channel.publish(gains), std::invalid_argument);
+  gains.dt = std::nan("");
+  EXPECT_THROW(channel.publish(gains), std::invalid_argument);
+  EXPECT_EQ(0u, channel.get_version());
+}
+
+// To test that compute() applies a published gain set on the next tick
+TEST(GainUpdateChannel_Test, compute_applies_published_gains) {
+  GainUpdateChannel channel;
+  PIDController pidController(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  pidController.set_gain_channel(&channel);
+  EXPECT_EQ(&channel, pidController.get_gain_channel());
+
+  GainSet gains = make_gains(1, 1, 1);
+  gains.max_value = 50.0;
+  channel.publish(gains);
+  EXPECT_EQ(0.1, pidController.get_kP());
+
+  EXPECT_EQ(50.0, pidController.compute(20.0, 10.0));
+  EXPECT_EQ(1.0, pidController.get_kP());
+  EXPECT_EQ(1.0, pidController.get_kI());
+  EXPECT_EQ(1.0, pidController.get_kD());
+  EXPECT_EQ(50.0, pidController.get_max_value());
+}
+
+// To test that a bumpless publish keeps P + I continuous
+TEST(GainUpdateChannel_Test, bumpless_transfer_keeps_output_continuous) {
+  GainUpdateChannel channel;
+  PIDController pidController(0.5, 0.5, 0, 100.0, -100.0, 0.1);
+  pidController.set_gain_channel(&channel);
+  double before = 0;
+  for (int i = 0; i < 20; ++i) {
+    before = pidController.compute(10.0, 8.0);
+  }
+
+  channel.publish(make_gains(2.0, 0.25, 0), true);
+  // Same error as before, so only the new integration step may change it.
+  double after = pidController.compute(10.0, 8.0);
+  EXPECT_NEAR(before + 0.25 * 2.0 * 0.1, after, 1e-9);
+}
+
+// To test that a reader never observes a half-written gain set while a
+// tuning thread publishes continuously
+TEST(GainUpdateChannel_Test, concurrent_reads_are_never_torn) {
+  Seqlock<GainSet> box;
+  std::atomic<bool> done(false);
+  std::thread writer([&box, &done]() {
+    for (int k = 1; k <= 20000; ++k) {
+      double v = static_cast<double>(k);
+      GainSet gains = {v, v, v, v, -v, v};
+      box.write(gains);
+    }
+    done.store(true);
+  });
+
+  while (!done.load()) {
+    GainSet gains;
+    if (box.try_read(&gains, nullptr)) {
+      ASSERT_EQ(gains.kP, gains.kI);
+      ASSERT_EQ(gains.kP, gains.kD);
+      ASSERT_EQ(gains.kP, gains.max_value);
+      ASSERT_EQ(-gains.kP, gains.min_value);
+      ASSERT_EQ(gains.kP, gains.dt);
+    }
+    std::this_thread::yield();
+  }
+  writer.join();
+  GainSet last;
+  ASSERT_TRUE(box.try_read(&last, nullptr));
+  EXPECT_EQ(20000.0, last.kP);
+  EXPECT_EQ(20000u, box.get_version());
+}
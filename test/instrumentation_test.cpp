@@ -0,0 +1,103 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include <instrumentation.hpp>
+#include <pid.hpp>
+
+// To test that every latency lands in a bucket whose bounds contain it
+TEST(Instrumentation_Test, buckets_contain_their_values) {
+  EXPECT_EQ(0u, LatencyBuckets::index(0));
+  EXPECT_EQ(7u, LatencyBuckets::index(7));
+  EXPECT_EQ(8u, LatencyBuckets::index(8));
+  EXPECT_EQ(LatencyBuckets::kCount - 1,
+            LatencyBuckets::index(UINT64_MAX));
+  for (uint64_t value = 0; value < 100000; value = value * 5 / 4 + 1) {
+    std::size_t bucket = LatencyBuckets::index(value);
+    ASSERT_LE(LatencyBuckets::lower_bound(bucket), value);
+    ASSERT_GE(LatencyBuckets::upper_bound(bucket), value);
+    // Relative width stays within one sub-bucket.
+    ASSERT_LE(LatencyBuckets::upper_bound(bucket) -
+                  LatencyBuckets::lower_bound(bucket),
+              value / LatencyBuckets::kSubBuckets);
+  }
+}
+
+// To test the counters and percentiles of a recorded sequence
+TEST(Instrumentation_Test, records_counters_and_percentiles) {
+  ComputeInstrumentation instrumentation;
+  for (uint64_t i = 1; i <= 100; ++i) {
+    instrumentation.record(i * 100, i % 10 == 0 ? 1 : (i % 25 == 0 ? -1 : 0),
+                           0.5, i < 50 ? 1.0 * i : 0.25);
+  }
+  InstrumentationSnapshot snapshot = instrumentation.snapshot();
+  EXPECT_EQ(100u, snapshot.calls);
+  EXPECT_EQ(10u, snapshot.saturated_max);
+  EXPECT_EQ(2u, snapshot.saturated_min);  // 25 and 75
+  EXPECT_EQ(49u, snapshot.integral_growth);
+  EXPECT_EQ(49.0, snapshot.peak_integral);
+  EXPECT_EQ(10000u, snapshot.max_latency_ns);
+  EXPECT_EQ(100u, snapshot.get_latency_count());
+  EXPECT_NEAR(5000.0, snapshot.get_latency_percentile(0.5), 5000.0 / 8);
+  EXPECT_NEAR(9900.0, snapshot.get_latency_percentile(0.99), 9900.0 / 8);
+  EXPECT_EQ(10000u, snapshot.get_latency_percentile(1.0));
+
+  ComputeInstrumentation copy(instrumentation);
+  EXPECT_EQ(100u, copy.snapshot().calls);
+  instrumentation.clear();
+  EXPECT_EQ(0u, instrumentation.snapshot().calls);
+  EXPECT_EQ(0u, instrumentation.snapshot().get_latency_percentile(0.5));
+}
+
+// To test that a reader thread can snapshot while the writer records
+TEST(Instrumentation_Test, concurrent_snapshots_are_monotonic) {
+  ComputeInstrumentation instrumentation;
+  std::atomic<bool> done(false);
+  std::thread writer([&]() {
+    for (uint64_t i = 0; i < 200000; ++i) {
+      instrumentation.record(i % 1000, 0, 0.0, 0.0);
+    }
+    done.store(true);
+  });
+  uint64_t last = 0;
+  while (!done.load()) {
+    uint64_t calls = instrumentation.snapshot().calls;
+    ASSERT_GE(calls, last);
+    last = calls;
+  }
+  writer.join();
+  EXPECT_EQ(200000u, instrumentation.snapshot().calls);
+  EXPECT_EQ(200000u, instrumentation.snapshot().get_latency_count());
+}
+
+#ifdef PID_INSTRUMENTATION
+// To test that compute() feeds the controller's instrumentation
+TEST(Instrumentation_Test, controller_counts_compute_calls) {
+  PIDController pidController(1.0, 1.0, 0.0, 2.0, -2.0, 0.1);
+  pidController.compute(10.0, 0.0);   // saturates high, integral grows
+  pidController.compute(-10.0, 0.0);  // saturates low, integral shrinks
+  pidController.compute(0.0, 0.0);    // within limits, integral unchanged
+  InstrumentationSnapshot snapshot =
+      pidController.get_instrumentation().snapshot();
+  EXPECT_EQ(3u, snapshot.calls);
+  EXPECT_EQ(1u, snapshot.saturated_max);
+  EXPECT_EQ(1u, snapshot.saturated_min);
+  EXPECT_EQ(1u, snapshot.integral_growth);
+  EXPECT_DOUBLE_EQ(1.0, snapshot.peak_integral);
+  EXPECT_EQ(3u, snapshot.get_latency_count());
+  pidController.clear_instrumentation();
+  EXPECT_EQ(0u, pidController.get_instrumentation().snapshot().calls);
+}
+#endif
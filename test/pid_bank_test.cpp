@@ -0,0 +1,139 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <pid.hpp>
+#include <pid_bank.hpp>
+
+namespace {
+
+bool same_bits(double a, double b) {
+  uint64_t x, y;
+  std::memcpy(&x, &a, sizeof(x));
+  std::memcpy(&y, &b, sizeof(y));
+  return x == y;
+}
+
+// Runs a bank and a matching set of PIDControllers over the same random
+// inputs and checks every output and state value bit for bit.
+void expect_bank_matches_controllers(PIDControllerBank::Kernel kernel) {
+  const std::size_t n = 37;  // not a multiple of any vector width
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> gain(-2.0, 2.0);
+  std::uniform_real_distribution<double> value(-50.0, 50.0);
+  std::uniform_real_distribution<double> step(0.001, 0.5);
+
+  PIDControllerBank bank;
+  bank.set_kernel(kernel);
+  std::vector<PIDController> controllers;
+  controllers.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    double kP = gain(rng), kI = gain(rng), kD = gain(rng);
+    double limit = 10.0 + value(rng) + 50.0;
+    double dt = step(rng);
+    bank.add(kP, kI, kD, limit, -limit, dt);
+    controllers.emplace_back(kP, kI, kD, limit, -limit, dt);
+  }
+
+  std::vector<double> setpoints(n), measured(n), out(n);
+  for (int tick = 0; tick < 50; ++tick) {
+    for (std::size_t i = 0; i < n; ++i) {
+      setpoints[i] = value(rng);
+      measured[i] = value(rng);
+    }
+    bank.compute(setpoints.data(), measured.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+      double expected = controllers[i].compute(setpoints[i], measured[i]);
+      ASSERT_TRUE(same_bits(expected, out[i])) << "controller " << i;
+      ASSERT_TRUE(same_bits(controllers[i].get_integral_sum(),
+                            bank.get_integral_sum(i)));
+      ASSERT_TRUE(same_bits(controllers[i].get_prev_error(),
+                            bank.get_prev_error(i)));
+    }
+  }
+}
+
+}  // namespace
+
+// To test that the scalar kernel is bit-identical to PIDController
+TEST(PIDControllerBank_Test, scalar_kernel_matches_pid_controller) {
+  expect_bank_matches_controllers(PIDControllerBank::Kernel::scalar);
+}
+
+// To test that the SSE2 kernel is bit-identical to PIDController
+TEST(PIDControllerBank_Test, sse2_kernel_matches_pid_controller) {
+  expect_bank_matches_controllers(PIDControllerBank::Kernel::sse2);
+}
+
+// To test that the AVX kernel is bit-identical to PIDController
+TEST(PIDControllerBank_Test, avx_kernel_matches_pid_controller) {
+  expect_bank_matches_controllers(PIDControllerBank::Kernel::avx);
+}
+
+// To test that the bank reproduces the values of test_compute_works
+TEST(PIDControllerBank_Test, compute_works) {
+  PIDControllerBank bank;
+  bank.add(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  double setpoint = 20.0, measured = 10.0, out = 0.0;
+  bank.compute(&setpoint, &measured, &out, 1);
+  EXPECT_NEAR(11.1, out, 0.001);
+  measured = 21.1;
+  bank.compute(&setpoint, &measured, &out, 1);
+  EXPECT_NEAR(-11.121, out, 0.001);
+}
+
+// To test that invalid dt, indices and batch sizes are rejected
+TEST(PIDControllerBank_Test, invalid_arguments_throw) {
+  PIDControllerBank bank;
+  EXPECT_THROW(bank.add(0.1, 0.1, 0.1, 100.0, -100.0, 0),
+               std::invalid_argument);
+  EXPECT_THROW(bank.add(0.1, 0.1, 0.1, 100.0, -100.0, std::nan("")),
+               std::invalid_argument);
+  std::size_t index = bank.add(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  EXPECT_THROW(bank.set_dt(index, -1), std::invalid_argument);
+  EXPECT_THROW(bank.set_dt(index, std::nan("")), std::invalid_argument);
+  EXPECT_EQ(0.1, bank.get_dt(index));
+  EXPECT_THROW(bank.get_kP(index + 1), std::out_of_range);
+
+  double setpoints[2] = {0, 0}, measured[2] = {0, 0}, out[2];
+  EXPECT_THROW(bank.compute(setpoints, measured, out, 2),
+               std::invalid_argument);
+}
+
+// To test that the setters and getters work and survive growing the bank
+TEST(PIDControllerBank_Test, setters_and_getters_survive_growth) {
+  PIDControllerBank bank(2);
+  bank.add(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  bank.set_kP(0, 0.2);
+  bank.set_kI(0, 0.3);
+  bank.set_kD(0, 0.4);
+  bank.set_max_value(0, 50.0);
+  bank.set_min_value(0, -50.0);
+  bank.set_dt(0, 0.2);
+  for (int i = 0; i < 100; ++i) {
+    bank.add(1, 1, 1, 1, -1, 1);
+  }
+  EXPECT_EQ(101u, bank.size());
+  EXPECT_EQ(0.2, bank.get_kP(0));
+  EXPECT_EQ(0.3, bank.get_kI(0));
+  EXPECT_EQ(0.4, bank.get_kD(0));
+  EXPECT_EQ(50.0, bank.get_max_value(0));
+  EXPECT_EQ(-50.0, bank.get_min_value(0));
+  EXPECT_EQ(0.2, bank.get_dt(0));
+}
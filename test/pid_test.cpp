@@ -154,3 +154,63 @@ TEST(PIDController_Test, compute_returns_min_val) {
 
 
 
+
+// To test if reset() clears the state so compute() repeats its first output
+TEST(PIDController_Test, reset_clears_state) {
+  std::unique_ptr<PIDController> pidController(
+      new PIDController(0.1, 0.1, 0.1, 100.0, -100.0, 0.1));
+  double first = pidController->compute(20.0, 10.0);
+  pidController->compute(20.0, 15.0);
+  pidController->reset();
+  EXPECT_EQ(0.0, pidController->get_integral_sum());
+  EXPECT_EQ(0.0, pidController->get_prev_error());
+  EXPECT_EQ(first, pidController->compute(20.0, 10.0));
+}
+
+// To test that the float and Q16.16 controllers stay within a bounded error
+// of the double reference. dt = 1/128 is exact in every type, so the
+// difference comes from rounding the arithmetic only.
+TEST(PIDController_Test, scalar_variants_track_double_reference) {
+  PIDController reference(0.4, 0.3, 0.05, 100.0, -100.0, 1.0 / 128);
+  BasicPIDController<float> single(0.4, 0.3, 0.05, 100.0, -100.0, 1.0 / 128);
+  BasicPIDController<Q16_16> fixed(0.4, 0.3, 0.05, 100.0, -100.0, 1.0 / 128);
+  for (int k = 0; k < 2000; ++k) {
+    double setpoint = k < 1000 ? 10.0 : -4.0;
+    double measured = 5.0 + 3.0 * ((k * 7) % 11) / 11.0 + 0.001 * k;
+    double expected = reference.compute(setpoint, measured);
+    ASSERT_NEAR(expected, single.compute(setpoint, measured), 1e-4);
+    ASSERT_NEAR(expected, fixed.compute(setpoint, measured), 1e-2);
+  }
+  EXPECT_NEAR(reference.get_integral_sum(), fixed.get_integral_sum(), 0.05);
+}
+
+// To test that Q16.16 saturates instead of wrapping when the unclamped
+// output overflows, so the clamp still picks the right limit
+TEST(PIDController_Test, fixed_point_clamp_is_overflow_safe) {
+  BasicPIDController<Q16_16> pidController(30000.0, 30000.0, 0.0, 100.0,
+                                            -100.0, 0.5);
+  EXPECT_EQ(100.0, pidController.compute(1000.0, 0.0));
+  EXPECT_EQ(-100.0, pidController.compute(-1000.0, 1000.0));
+  EXPECT_EQ(Q16_16(100.0),
+            pidController.compute_native(Q16_16(1000.0), Q16_16(0.0)));
+  EXPECT_THROW(BasicPIDController<Q16_16>(1, 1, 1, 1, -1, 1e-6),
+               std::invalid_argument);
+}
+
+// To test that compute_with_dt() matches compute() when the step equals dt
+// and integrates over the given step otherwise
+TEST(PIDController_Test, compute_with_dt_uses_given_step) {
+  PIDController fixed(0.7, 0.4, 0.05, 100.0, -100.0, 0.02);
+  PIDController variable(0.7, 0.4, 0.05, 100.0, -100.0, 0.02);
+  for (int k = 0; k < 50; ++k) {
+    double measured = 0.03 * k;
+    ASSERT_EQ(fixed.compute(1.0, measured),
+              variable.compute_with_dt(1.0, measured, 0.02));
+  }
+  double integral = variable.get_integral_sum();
+  variable.compute_with_dt(2.0, 1.0, 0.5);
+  EXPECT_DOUBLE_EQ(integral + 0.5, variable.get_integral_sum());
+  EXPECT_EQ(0.02, variable.get_dt());
+  EXPECT_THROW(variable.compute_with_dt(1.0, 1.0, 0.0),
+               std::invalid_argument);
+}
@@ -0,0 +1,62 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+
+#include <plant.hpp>
+
+// To test that a first-order plant follows the exact step response
+TEST(Plant_Test, first_order_step_response) {
+  DiscretePlant plant(first_order_plant(2.0, 0.5), 0.01);
+  for (int k = 0; k < 50; ++k) {
+    plant.step(1.0);
+  }
+  EXPECT_NEAR(2.0 * (1 - std::exp(-1.0)), plant.output(), 1e-12);
+}
+
+// To test that a second-order plant settles at its static gain
+TEST(Plant_Test, second_order_settles_at_gain) {
+  DiscretePlant plant(second_order_plant(3.0, 4.0, 0.7), 0.001);
+  for (int k = 0; k < 10000; ++k) {
+    plant.step(1.0);
+  }
+  EXPECT_NEAR(3.0, plant.output(), 1e-6);
+}
+
+// To test that the transport delay holds the input back by whole samples
+TEST(Plant_Test, dead_time_delays_input) {
+  DiscretePlant plant(dead_time_plant(2.0, 0.3), 0.1);
+  for (int k = 0; k < 3; ++k) {
+    plant.step(1.0);
+    EXPECT_DOUBLE_EQ(0.0, plant.output());
+  }
+  plant.step(1.0);
+  EXPECT_DOUBLE_EQ(2.0, plant.output());
+
+  plant.reset();
+  EXPECT_DOUBLE_EQ(0.0, plant.output());
+  plant.step(1.0);
+  EXPECT_DOUBLE_EQ(0.0, plant.output());
+}
+
+// To test that invalid plant parameters are rejected
+TEST(Plant_Test, invalid_parameters_throw) {
+  EXPECT_THROW(discretize(first_order_plant(1.0, 0.0), 0.1),
+               std::invalid_argument);
+  EXPECT_THROW(discretize(second_order_plant(1.0, -1.0, 0.5), 0.1),
+               std::invalid_argument);
+  EXPECT_THROW(discretize(first_order_plant(1.0, 1.0, -0.1), 0.1),
+               std::invalid_argument);
+  EXPECT_THROW(discretize(first_order_plant(1.0, 1.0), 0.0),
+               std::invalid_argument);
+}
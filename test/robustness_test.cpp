@@ -0,0 +1,155 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+
+#include <pid.hpp>
+#include <plant.hpp>
+#include <robustness.hpp>
+#include <simulation.hpp>
+
+namespace {
+
+GainSet pi_gains() {
+  GainSet gains = {0.8, 1.5, 0.0, 100.0, -100.0, 0.01};
+  return gains;
+}
+
+RobustnessOptions small_options(std::size_t samples) {
+  RobustnessOptions options;
+  options.samples = samples;
+  options.simulation.steps = 600;
+  options.seed = 7;
+  return options;
+}
+
+}  // namespace
+
+// To test histogram counts, percentiles and merging
+TEST(Robustness_Test, histogram_percentiles_and_merge) {
+  Histogram low(0.0, 100.0, 100);
+  Histogram high(0.0, 100.0, 100);
+  EXPECT_EQ(0.0, low.get_percentile(0.5));
+  for (int i = 0; i < 50; ++i) {
+    low.add(i + 0.5);
+    high.add(i + 50.5);
+  }
+  high.add(250.0);  // overflow
+  low.merge(high);
+  EXPECT_EQ(101u, low.get_count());
+  EXPECT_EQ(0.5, low.get_min());
+  EXPECT_EQ(250.0, low.get_max());
+  EXPECT_EQ(51.0, low.get_percentile(0.5));
+  EXPECT_EQ(11.0, low.get_percentile(0.1));
+  EXPECT_EQ(250.0, low.get_percentile(1.0));
+  EXPECT_DOUBLE_EQ((100.0 * 100.0 / 2 + 250.0) / 101.0, low.get_mean());
+
+  EXPECT_THROW(low.merge(Histogram(0.0, 100.0, 10)), std::invalid_argument);
+  EXPECT_THROW(Histogram(1.0, 1.0, 10), std::invalid_argument);
+}
+
+// To test that without any spread every sample matches one simulation
+TEST(Robustness_Test, fixed_plant_matches_single_simulation) {
+  PlantDistribution plants = uniform_spread(first_order_plant(1.0, 0.5), 0.0);
+  RobustnessOptions options = small_options(300);
+  RobustnessReport report = analyze_robustness(pi_gains(), plants, options);
+
+  GainSet gains = pi_gains();
+  PIDController controller(gains.kP, gains.kI, gains.kD, gains.max_value,
+                           gains.min_value, gains.dt);
+  StepResponseMetrics expected = simulate_step_response(
+      &controller, first_order_plant(1.0, 0.5), options.simulation);
+  ASSERT_TRUE(expected.settled);
+  EXPECT_EQ(300u, report.samples);
+  EXPECT_EQ(300u, report.settled);
+  EXPECT_EQ(0u, report.diverged);
+  EXPECT_EQ(1.0, report.get_stability_rate());
+  EXPECT_EQ(1.0, report.get_settled_rate());
+  EXPECT_EQ(expected.settling_time, report.settling_time.get_percentile(0.9));
+  EXPECT_EQ(expected.overshoot, report.overshoot.get_percentile(0.5));
+  EXPECT_EQ(expected.iae, report.iae.get_max());
+  EXPECT_NEAR(expected.iae, report.iae.get_mean(), 1e-12);
+}
+
+// To test that the report does not depend on the thread count and that the
+// sampled plants stay inside the spread
+TEST(Robustness_Test, report_is_independent_of_threads) {
+  PlantDistribution plants =
+      uniform_spread(first_order_plant(1.0, 0.5, 0.05), 0.3);
+  RobustnessOptions options = small_options(2000);
+  options.threads = 1;
+  RobustnessReport serial = analyze_robustness(pi_gains(), plants, options);
+  options.threads = 4;
+  RobustnessReport parallel = analyze_robustness(pi_gains(), plants, options);
+
+  EXPECT_EQ(2000u, serial.samples);
+  EXPECT_EQ(serial.settled, parallel.settled);
+  EXPECT_EQ(serial.diverged, parallel.diverged);
+  EXPECT_EQ(serial.overshoot.get_percentile(0.99),
+            parallel.overshoot.get_percentile(0.99));
+  EXPECT_EQ(serial.settling_time.get_percentile(0.5),
+            parallel.settling_time.get_percentile(0.5));
+  EXPECT_EQ(serial.iae.get_mean(), parallel.iae.get_mean());
+  EXPECT_EQ(serial.worst_iae, parallel.worst_iae);
+  EXPECT_EQ(serial.worst_plant.time_constant,
+            parallel.worst_plant.time_constant);
+  EXPECT_LE(std::fabs(serial.worst_plant.time_constant - 0.5), 0.15);
+  EXPECT_LE(std::fabs(serial.worst_plant.dead_time - 0.05), 0.015);
+  // A different seed draws different plants.
+  options.seed = 8;
+  RobustnessReport other = analyze_robustness(pi_gains(), plants, options);
+  EXPECT_NE(serial.iae.get_mean(), other.iae.get_mean());
+}
+
+// To test that aggressive gains on an uncertain delay lose stability in
+// part of the samples and that the worst plant is a diverged one
+TEST(Robustness_Test, aggressive_gains_diverge_on_some_plants) {
+  GainSet gains = {4.0, 8.0, 0.0, 1e6, -1e6, 0.01};
+  PlantDistribution plants;
+  plants.nominal = first_order_plant(1.0, 0.3, 0.08);
+  plants.dead_time.distribution = Distribution::normal;
+  plants.dead_time.spread = 0.3;
+  RobustnessOptions options = small_options(1000);
+  options.simulation.steps = 1500;
+  RobustnessReport report = analyze_robustness(gains, plants, options);
+
+  EXPECT_EQ(1000u, report.samples);
+  EXPECT_GT(report.diverged, 0u);
+  EXPECT_LT(report.get_stability_rate(), 1.0);
+  EXPECT_GE(report.samples, report.settled + report.diverged);
+  EXPECT_DOUBLE_EQ(1.0 - static_cast<double>(report.diverged) / 1000,
+                   report.get_stability_rate());
+  EXPECT_LE(report.get_settled_rate(), report.get_stability_rate());
+  EXPECT_TRUE(std::isinf(report.worst_iae));
+  EXPECT_GT(report.worst_plant.dead_time, 0.08);
+}
+
+// To test the argument checks
+TEST(Robustness_Test, invalid_arguments_throw) {
+  PlantDistribution plants = uniform_spread(first_order_plant(1.0, 0.5), 0.3);
+  RobustnessOptions options = small_options(0);
+  EXPECT_THROW(analyze_robustness(pi_gains(), plants, options),
+               std::invalid_argument);
+  options.samples = 10;
+  plants.damping.distribution = Distribution::normal;
+  plants.damping.spread = 0.4;
+  EXPECT_THROW(analyze_robustness(pi_gains(), plants, options),
+               std::invalid_argument);
+  EXPECT_THROW(uniform_spread(first_order_plant(1.0, 0.5), 1.0),
+               std::invalid_argument);
+  plants.damping.spread = 0.1;
+  GainSet gains = pi_gains();
+  gains.dt = 0;
+  EXPECT_THROW(analyze_robustness(gains, plants, options),
+               std::invalid_argument);
+}
@@ -0,0 +1,122 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <pid.hpp>
+#include <sensor_ingest.hpp>
+
+// To test that queued samples are all computed, in order, over the time
+// elapsed between their timestamps
+TEST(SensorIngest_Test, queue_computes_every_sample_with_elapsed_dt) {
+  PIDController fed(1.0, 0.5, 0.1, 100.0, -100.0, 0.01);
+  PIDController expected(1.0, 0.5, 0.1, 100.0, -100.0, 0.01);
+  SensorIngest ingest(8);
+  std::size_t channel = ingest.add_channel(&fed, 2.0, IngestMode::queue);
+
+  const double timestamps[] = {1.0, 1.01, 1.025, 1.03, 1.05};
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(ingest.publish(channel, {timestamps[i], 0.1 * i}));
+  }
+  double output = 0;
+  EXPECT_EQ(5u, ingest.drain(&output));
+
+  double last = expected.compute_with_dt(2.0, 0.0, 0.01);
+  for (int i = 1; i < 5; ++i) {
+    last = expected.compute_with_dt(2.0, 0.1 * i,
+                                    timestamps[i] - timestamps[i - 1]);
+  }
+  EXPECT_EQ(last, output);
+  EXPECT_EQ(expected.get_integral_sum(), fed.get_integral_sum());
+  EXPECT_EQ(0u, ingest.drain(&output));
+  EXPECT_EQ(last, ingest.get_output(channel));
+
+  // A queue holds at most its capacity; the rest is dropped and counted.
+  for (int i = 0; i < 10; ++i) {
+    ingest.publish(channel, {2.0 + i, 0.0});
+  }
+  EXPECT_EQ(8u, ingest.drain(nullptr));
+  EXPECT_EQ(2u, ingest.get_stats(channel).dropped);
+  EXPECT_EQ(13u, ingest.get_stats(channel).computed);
+}
+
+// To test that a latest-value channel computes only the newest sample
+TEST(SensorIngest_Test, latest_overwrites_older_samples) {
+  PIDController fed(2.0, 1.0, 0.0, 100.0, -100.0, 0.1);
+  PIDController expected(2.0, 1.0, 0.0, 100.0, -100.0, 0.1);
+  SensorIngest ingest;
+  std::size_t channel = ingest.add_channel(&fed, 1.0, IngestMode::latest);
+
+  ingest.publish(channel, {0.0, 0.5});
+  EXPECT_EQ(1u, ingest.drain(nullptr));
+  expected.compute_with_dt(1.0, 0.5, 0.1);
+
+  ingest.publish(channel, {0.1, 0.6});
+  ingest.publish(channel, {0.2, 0.7});
+  ingest.publish(channel, {0.3, 0.8});
+  ingest.set_setpoint(channel, 3.0);
+  EXPECT_EQ(1u, ingest.drain(nullptr));
+  EXPECT_EQ(expected.compute_with_dt(3.0, 0.8, 0.3),
+            ingest.get_output(channel));
+  EXPECT_EQ(0u, ingest.drain(nullptr));
+
+  IngestStats stats = ingest.get_stats(channel);
+  EXPECT_EQ(2u, stats.computed);
+  EXPECT_EQ(2u, stats.overwritten);
+  EXPECT_EQ(0u, stats.dropped);
+
+  // A timestamp that does not move forward is skipped.
+  ingest.publish(channel, {0.3, 5.0});
+  EXPECT_EQ(0u, ingest.drain(nullptr));
+  EXPECT_EQ(1u, ingest.get_stats(channel).out_of_order);
+}
+
+// To test a producer thread feeding the control thread concurrently
+TEST(SensorIngest_Test, concurrent_producer) {
+  PIDController fed(0.1, 0.01, 0.0, 1e9, -1e9, 0.001);
+  SensorIngest ingest(1024);
+  std::size_t channel = ingest.add_channel(&fed, 0.0, IngestMode::queue);
+  const int kSamples = 100000;
+  std::atomic<bool> done(false);
+  std::thread producer([&]() {
+    for (int i = 0; i < kSamples; ++i) {
+      while (!ingest.publish(channel, {0.001 * (i + 1), 1.0})) {
+        std::this_thread::yield();
+      }
+    }
+    done.store(true);
+  });
+  std::size_t computed = 0;
+  while (!done.load()) {
+    computed += ingest.drain(nullptr);
+  }
+  producer.join();
+  computed += ingest.drain(nullptr);
+  EXPECT_EQ(static_cast<std::size_t>(kSamples), computed);
+  EXPECT_EQ(0u, ingest.get_stats(channel).out_of_order);
+  EXPECT_NEAR(-0.001 * kSamples, fed.get_integral_sum(), 1e-6);
+}
+
+// To test the argument checks
+TEST(SensorIngest_Test, invalid_arguments_throw) {
+  PIDController controller(1, 1, 1, 1, -1, 1);
+  EXPECT_THROW(SensorIngest(0), std::invalid_argument);
+  SensorIngest ingest;
+  EXPECT_THROW(ingest.add_channel(nullptr, 0.0, IngestMode::queue),
+               std::invalid_argument);
+  ingest.add_channel(&controller, 0.0, IngestMode::latest);
+  EXPECT_EQ(1u, ingest.get_channel_count());
+  EXPECT_THROW(ingest.publish(1, {0.0, 0.0}), std::out_of_range);
+  EXPECT_THROW(ingest.get_stats(1), std::out_of_range);
+}
@@ -0,0 +1,189 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pid.hpp>
+#include <shm_controller.hpp>
+
+namespace {
+
+std::string segment_name(const std::string& name) {
+  return "/pid_shm_test_" + std::to_string(getpid()) + "_" + name;
+}
+
+std::vector<GainSet> make_gains() {
+  std::vector<GainSet> gains;
+  GainSet a = {1.0, 0.5, 0.01, 10.0, -10.0, 0.01};
+  GainSet b = {0.3, 0.0, 0.2, 5.0, -5.0, 0.02};
+  gains.push_back(a);
+  gains.push_back(b);
+  return gains;
+}
+
+}  // namespace
+
+// To test that every slot answers exactly like a local PIDController
+TEST(ShmController_Test, slots_match_local_controllers) {
+  std::string name = segment_name("match");
+  ShmControllerServer server(name, make_gains());
+  server.start();
+  ShmControllerClient first(name, 0);
+  ShmControllerClient second(name, 1);
+  EXPECT_EQ(2u, second.get_slot_count());
+  PIDController local_first(1.0, 0.5, 0.01, 10.0, -10.0, 0.01);
+  PIDController local_second(0.3, 0.0, 0.2, 5.0, -5.0, 0.02);
+  for (int k = 0; k < 200; ++k) {
+    double measured = 0.05 * (k % 17);
+    ASSERT_EQ(local_first.compute(1.0, measured),
+              first.compute(1.0, measured));
+    ASSERT_EQ(local_second.compute(-1.0, measured),
+              second.compute(-1.0, measured));
+  }
+  server.stop();
+  EXPECT_EQ(400u, server.get_served());
+  EXPECT_THROW(first.compute(1.0, 0.0), std::runtime_error);
+}
+
+// To test pipelined requests and the ring capacity limit
+TEST(ShmController_Test, pipelined_requests_keep_their_order) {
+  std::string name = segment_name("pipeline");
+  ShmControllerServer server(name, make_gains());
+  ShmControllerClient client(name, 0);
+  PIDController local(1.0, 0.5, 0.01, 10.0, -10.0, 0.01);
+  double output;
+  EXPECT_FALSE(client.try_receive(&output));
+  EXPECT_THROW(client.receive(), std::logic_error);
+  for (uint32_t i = 0; i < kShmRingCapacity; ++i) {
+    EXPECT_TRUE(client.submit(2.0, 0.1 * i));
+  }
+  EXPECT_FALSE(client.submit(2.0, 0.0));
+  EXPECT_THROW(client.compute(2.0, 0.0), std::logic_error);
+  EXPECT_EQ(kShmRingCapacity, server.poll());
+  for (uint32_t i = 0; i < kShmRingCapacity; ++i) {
+    ASSERT_TRUE(client.try_receive(&output));
+    EXPECT_EQ(local.compute(2.0, 0.1 * i), output);
+  }
+  EXPECT_FALSE(client.try_receive(&output));
+}
+
+// To test a client in another process
+TEST(ShmController_Test, client_in_child_process) {
+  std::string name = segment_name("fork");
+  ShmControllerServer server(name, make_gains());
+  server.start();
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    int status = 0;
+    try {
+      ShmControllerClient client(name, 1);
+      PIDController local(0.3, 0.0, 0.2, 5.0, -5.0, 0.02);
+      for (int k = 0; k < 100; ++k) {
+        if (client.compute(0.5, 0.01 * k) != local.compute(0.5, 0.01 * k)) {
+          status = 1;
+        }
+      }
+    } catch (...) {
+      status = 2;
+    }
+    _exit(status);
+  }
+  int status = -1;
+  ASSERT_EQ(child, waitpid(child, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+  // The count is updated after the outputs are published.
+  server.stop();
+  EXPECT_EQ(100u, server.get_served());
+  // The child exited holding no slot, so slot 1 can be claimed again.
+  ShmControllerClient again(name, 1);
+}
+
+// To test that a client taking over a slot does not overwrite requests of
+// the previous client that the server has not read yet
+TEST(ShmController_Test, takeover_waits_for_unanswered_requests) {
+  std::string name = segment_name("takeover");
+  ShmControllerServer server(name, make_gains());
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // Fill the ring while nobody serves it and exit holding the slot.
+    ShmControllerClient client(name, 0);
+    int status = 0;
+    for (uint32_t i = 0; i < kShmRingCapacity; ++i) {
+      if (!client.submit(1.0, 0.1 * i)) {
+        status = 1;
+      }
+    }
+    _exit(status);
+  }
+  int status = -1;
+  ASSERT_EQ(child, waitpid(child, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(0, WEXITSTATUS(status));
+
+  ShmControllerClient client(name, 0);
+  EXPECT_FALSE(client.submit(5.0, 0.0));
+  server.start();
+  PIDController local(1.0, 0.5, 0.01, 10.0, -10.0, 0.01);
+  for (uint32_t i = 0; i < kShmRingCapacity; ++i) {
+    local.compute(1.0, 0.1 * i);
+  }
+  EXPECT_EQ(local.compute(5.0, 0.0), client.compute(5.0, 0.0));
+}
+
+// To test that bad names, missing servers and busy slots are rejected
+TEST(ShmController_Test, invalid_use_throws) {
+  std::string name = segment_name("invalid");
+  EXPECT_THROW(ShmControllerServer("no-slash", make_gains()),
+               std::invalid_argument);
+  EXPECT_THROW(ShmControllerServer(name, std::vector<GainSet>()),
+               std::invalid_argument);
+  std::vector<GainSet> bad = make_gains();
+  bad[1].dt = 0;
+  EXPECT_THROW(ShmControllerServer(name, bad), std::invalid_argument);
+  EXPECT_THROW(ShmControllerClient(name, 0), std::runtime_error);
+
+  ShmControllerServer server(name, make_gains());
+  EXPECT_THROW(ShmControllerClient(name, 2), std::out_of_range);
+  ShmControllerClient client(name, 0);
+  EXPECT_THROW(ShmControllerClient(name, 0), std::runtime_error);
+  // A live server keeps its name.
+  EXPECT_THROW(ShmControllerServer(name, make_gains()), std::runtime_error);
+  server.start();
+  EXPECT_THROW(server.start(), std::logic_error);
+}
+
+// To test that a segment left behind by a server that is gone is replaced
+TEST(ShmController_Test, stale_segment_is_replaced) {
+  std::string name = segment_name("stale");
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // Exit without running destructors, like a crashed server.
+    new ShmControllerServer(name, make_gains());
+    _exit(0);
+  }
+  int status = -1;
+  ASSERT_EQ(child, waitpid(child, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  ShmControllerServer server(name, make_gains());
+  server.start();
+  ShmControllerClient client(name, 1);
+  PIDController local(0.3, 0.0, 0.2, 5.0, -5.0, 0.02);
+  EXPECT_EQ(local.compute(1.0, 0.0), client.compute(1.0, 0.0));
+}
@@ -0,0 +1,138 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <pid.hpp>
+#include <plant.hpp>
+#include <simulation.hpp>
+
+namespace {
+
+GainSet make_gains(double kP, double kI, double kD, double dt) {
+  GainSet gains = {kP, kI, kD, 100.0, -100.0, dt};
+  return gains;
+}
+
+PlantParams plant_for(std::size_t i) {
+  switch (i % 3) {
+    case 0:
+      return first_order_plant(1.0 + 0.001 * static_cast<double>(i), 0.5);
+    case 1:
+      return second_order_plant(1.0, 3.0,
+                                0.4 + 0.0001 * static_cast<double>(i));
+    default:
+      return first_order_plant(1.0, 0.4, 0.05);
+  }
+}
+
+}  // namespace
+
+// To test that a PI loop on a first-order plant settles without diverging
+TEST(Simulation_Test, pi_loop_settles) {
+  std::unique_ptr<PIDController> pid(
+      new PIDController(2.0, 2.0, 0.0, 100.0, -100.0, 0.01));
+  SimulationOptions options;
+  options.steps = 2000;
+  StepResponseMetrics metrics =
+      simulate_step_response(pid.get(), first_order_plant(1.0, 0.5), options);
+  EXPECT_TRUE(metrics.settled);
+  EXPECT_FALSE(metrics.diverged);
+  EXPECT_GT(metrics.rise_time, 0.0);
+  EXPECT_LT(metrics.rise_time, metrics.settling_time);
+  EXPECT_GE(metrics.overshoot, 0.0);
+  EXPECT_NEAR(1.0, metrics.final_value, 0.02);
+  EXPECT_GT(metrics.iae, 0.0);
+  EXPECT_GT(metrics.ise, 0.0);
+}
+
+// To test that a proportional-only loop keeps its steady-state error
+TEST(Simulation_Test, p_loop_does_not_settle) {
+  std::unique_ptr<PIDController> pid(
+      new PIDController(1.0, 0.0, 0.0, 100.0, -100.0, 0.01));
+  SimulationOptions options;
+  options.steps = 2000;
+  std::vector<double> trajectory;
+  StepResponseMetrics metrics = simulate_step_response(
+      pid.get(), first_order_plant(1.0, 0.5), options, &trajectory);
+  EXPECT_FALSE(metrics.settled);
+  EXPECT_TRUE(std::isinf(metrics.settling_time));
+  EXPECT_TRUE(std::isinf(metrics.rise_time));
+  EXPECT_NEAR(0.5, metrics.final_value, 1e-6);
+  ASSERT_EQ(options.steps, trajectory.size());
+  EXPECT_DOUBLE_EQ(0.0, trajectory[0]);
+}
+
+// To test that an unstable loop is aborted early and reported as diverged
+TEST(Simulation_Test, unstable_loop_diverges) {
+  std::unique_ptr<PIDController> pid(
+      new PIDController(5.0, 0.0, 0.0, 1e12, -1e12, 0.1));
+  SimulationOptions options;
+  std::vector<double> trajectory;
+  StepResponseMetrics metrics = simulate_step_response(
+      pid.get(), dead_time_plant(1.0, 0.2), options, &trajectory);
+  EXPECT_TRUE(metrics.diverged);
+  EXPECT_FALSE(metrics.settled);
+  EXPECT_TRUE(std::isinf(metrics.iae));
+  EXPECT_LT(trajectory.size(), options.steps);
+}
+
+// To test that the batch simulator matches single simulations exactly
+TEST(Simulation_Test, batch_matches_single_runs) {
+  ClosedLoopSimulator simulator;
+  const std::size_t count = 3 * ClosedLoopSimulator::kChunkSize + 17;
+  for (std::size_t i = 0; i < count; ++i) {
+    double kP = 0.5 + 0.01 * static_cast<double>(i % 200);
+    EXPECT_EQ(i, simulator.add(make_gains(kP, 1.0, 0.05, 0.01), plant_for(i)));
+  }
+  ASSERT_EQ(count, simulator.size());
+
+  SimulationOptions options;
+  options.steps = 400;
+  options.record_trajectory = true;
+  std::vector<StepResponseMetrics> batch = simulator.run(options, 4);
+  ASSERT_EQ(count, batch.size());
+
+  for (std::size_t i = 0; i < count; i += 37) {
+    double kP = 0.5 + 0.01 * static_cast<double>(i % 200);
+    PIDController pid(kP, 1.0, 0.05, 100.0, -100.0, 0.01);
+    std::vector<double> trajectory;
+    StepResponseMetrics single =
+        simulate_step_response(&pid, plant_for(i), options, &trajectory);
+    EXPECT_EQ(single.iae, batch[i].iae);
+    EXPECT_EQ(single.ise, batch[i].ise);
+    EXPECT_EQ(single.overshoot, batch[i].overshoot);
+    EXPECT_EQ(single.rise_time, batch[i].rise_time);
+    EXPECT_EQ(single.settling_time, batch[i].settling_time);
+    EXPECT_EQ(single.final_value, batch[i].final_value);
+    EXPECT_EQ(trajectory, simulator.get_trajectory(i));
+  }
+  EXPECT_THROW(simulator.get_trajectory(count), std::out_of_range);
+
+  options.record_trajectory = false;
+  simulator.run(options, 2);
+  EXPECT_THROW(simulator.get_trajectory(0), std::logic_error);
+}
+
+// To test that invalid experiments and plants are rejected
+TEST(Simulation_Test, invalid_input_throws) {
+  ClosedLoopSimulator simulator;
+  EXPECT_THROW(simulator.add(make_gains(1, 1, 0, 0.0), plant_for(0)),
+               std::invalid_argument);
+  EXPECT_EQ(0u, simulator.size());
+  SimulationOptions options;
+  options.setpoint = 0;
+  EXPECT_THROW(simulator.run(options), std::invalid_argument);
+}
@@ -0,0 +1,171 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pid.hpp>
+#include <pid_bank.hpp>
+#include <snapshot.hpp>
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+  return "/tmp/pid_snapshot_test_" + std::to_string(getpid()) + "_" + name;
+}
+
+double measured_at(int k, std::size_t i) {
+  return 0.1 * i + 0.5 * ((k * 7 + static_cast<int>(i)) % 13) / 13.0;
+}
+
+}  // namespace
+
+// To test that controllers restored from a snapshot continue exactly like
+// the ones that were saved
+TEST(ControllerSnapshot_Test, restored_controllers_resume_bit_identically) {
+  std::string path = temp_path("objects.snap");
+  std::vector<PIDController> running;
+  for (std::size_t i = 0; i < 4; ++i) {
+    running.emplace_back(0.5 + i, 0.2, 0.05 * i, 10.0, -10.0, 0.01);
+  }
+  {
+    ControllerSnapshot snapshot(path, running.size());
+    EXPECT_FALSE(snapshot.is_complete());
+    snapshot.set_interval(10);
+    for (int k = 0; k < 35; ++k) {
+      for (std::size_t i = 0; i < running.size(); ++i) {
+        running[i].compute(1.0, measured_at(k, i));
+      }
+      EXPECT_EQ(k % 10 == 0, snapshot.tick(running.data(), running.size()));
+    }
+    EXPECT_EQ(4u, snapshot.get_save_count());
+    // Run on past the last save, then save the current state explicitly.
+    snapshot.save(running.data(), running.size());
+  }
+
+  ControllerSnapshot reopened(path);
+  ASSERT_TRUE(reopened.is_complete());
+  EXPECT_EQ(4u, reopened.size());
+  EXPECT_EQ(running[2].get_integral_sum(),
+            reopened.get_record(2).integral_sum);
+  std::vector<PIDController> restored(4, PIDController(1, 1, 1, 1, -1, 1));
+  reopened.restore(restored.data(), restored.size());
+  for (int k = 35; k < 100; ++k) {
+    for (std::size_t i = 0; i < running.size(); ++i) {
+      ASSERT_EQ(running[i].compute(1.0, measured_at(k, i)),
+                restored[i].compute(1.0, measured_at(k, i)));
+    }
+  }
+  PIDController single(1, 1, 1, 1, -1, 1);
+  reopened.restore(3, &single);
+  EXPECT_EQ(reopened.get_record(3).prev_error, single.get_prev_error());
+  std::remove(path.c_str());
+}
+
+// To test saving a bank and restoring it into an empty one
+TEST(ControllerSnapshot_Test, bank_round_trip) {
+  std::string path = temp_path("bank.snap");
+  PIDControllerBank bank;
+  for (std::size_t i = 0; i < 100; ++i) {
+    bank.add(0.1 * i, 0.3, 0.01, 5.0, -5.0, 0.02);
+  }
+  std::vector<double> setpoints(100, 2.0), measured(100), out(100);
+  std::vector<double> restored_out(100);
+  for (int k = 0; k < 20; ++k) {
+    for (std::size_t i = 0; i < 100; ++i) {
+      measured[i] = measured_at(k, i);
+    }
+    bank.compute(setpoints.data(), measured.data(), out.data(), 100);
+  }
+  ControllerSnapshot snapshot(path, 100);
+  EXPECT_TRUE(snapshot.tick(bank));
+
+  PIDControllerBank restored;
+  ControllerSnapshot(path).restore(&restored);
+  ASSERT_EQ(100u, restored.size());
+  for (int k = 20; k < 60; ++k) {
+    for (std::size_t i = 0; i < 100; ++i) {
+      measured[i] = measured_at(k, i);
+    }
+    bank.compute(setpoints.data(), measured.data(), out.data(), 100);
+    restored.compute(setpoints.data(), measured.data(), restored_out.data(),
+                     100);
+    ASSERT_EQ(out, restored_out);
+  }
+  // A bank of the right size is overwritten in place.
+  snapshot.save(bank);
+  snapshot.restore(&restored);
+  EXPECT_EQ(bank.get_integral_sum(42), restored.get_integral_sum(42));
+  std::remove(path.c_str());
+}
+
+// To test that unusable snapshots and mismatched sizes are rejected
+TEST(ControllerSnapshot_Test, invalid_snapshots_throw) {
+  std::string path = temp_path("bad.snap");
+  PIDController controller(1, 1, 1, 1, -1, 1);
+  EXPECT_THROW(ControllerSnapshot(temp_path("missing")), std::runtime_error);
+  EXPECT_THROW(ControllerSnapshot(path, 0), std::invalid_argument);
+  {
+    ControllerSnapshot snapshot(path, 2);
+    EXPECT_THROW(snapshot.restore(0, &controller), std::runtime_error);
+    EXPECT_THROW(snapshot.save(&controller, 1), std::invalid_argument);
+    EXPECT_THROW(snapshot.save(2, controller), std::out_of_range);
+    EXPECT_THROW(snapshot.set_interval(0), std::invalid_argument);
+    // Single records do not make a fresh file restorable.
+    snapshot.save(0, controller);
+    snapshot.save(1, controller);
+    EXPECT_FALSE(snapshot.is_complete());
+    EXPECT_THROW(snapshot.restore(0, &controller), std::runtime_error);
+    PIDController both[] = {controller, controller};
+    snapshot.save(both, 2);
+    EXPECT_TRUE(snapshot.is_complete());
+    snapshot.save(1, controller);
+    EXPECT_TRUE(snapshot.is_complete());
+    EXPECT_EQ(2u, snapshot.get_save_count());
+    PIDControllerBank wrong_size;
+    wrong_size.add(1, 1, 1, 1, -1, 1);
+    EXPECT_THROW(snapshot.restore(&wrong_size), std::invalid_argument);
+  }
+  {
+    // A save that never finished leaves an odd sequence number.
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    uint64_t sequence = 5;
+    file.seekp(offsetof(SnapshotHeader, sequence));
+    file.write(reinterpret_cast<const char*>(&sequence), sizeof(sequence));
+  }
+  ControllerSnapshot interrupted(path);
+  EXPECT_FALSE(interrupted.is_complete());
+  EXPECT_THROW(interrupted.restore(0, &controller), std::runtime_error);
+  // Saving one record does not vouch for the torn ones.
+  interrupted.save(0, controller);
+  EXPECT_FALSE(interrupted.is_complete());
+  EXPECT_THROW(interrupted.restore(0, &controller), std::runtime_error);
+  // A whole-set save does.
+  PIDController both[] = {controller, controller};
+  interrupted.save(both, 2);
+  EXPECT_TRUE(interrupted.is_complete());
+  EXPECT_EQ(4u, interrupted.get_save_count());
+  interrupted.restore(1, &controller);
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "not a snapshot, but long enough to hold a header......"
+         << "..........";
+  }
+  EXPECT_THROW(ControllerSnapshot{path}, std::runtime_error);
+  std::remove(path.c_str());
+}
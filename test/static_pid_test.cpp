@@ -0,0 +1,125 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+
+#include <pid.hpp>
+#include <static_pid.hpp>
+
+namespace {
+
+struct TestGains {
+  static constexpr double kP = 0.1;
+  static constexpr double kI = 0.1;
+  static constexpr double kD = 0.1;
+  static constexpr double max_value = 100.0;
+  static constexpr double min_value = -100.0;
+  static constexpr double dt = 0.1;
+};
+
+}  // namespace
+
+// To test that the default policies follow PIDController
+TEST(StaticPIDController_Test, default_policies_match_pid_controller) {
+  StaticPIDController<double> staticController(0.5, 0.3, 0.05, 10.0, -10.0,
+                                               0.01);
+  PIDController pidController(0.5, 0.3, 0.05, 10.0, -10.0, 0.01);
+  for (int i = 0; i < 200; ++i) {
+    double setpoint = (i < 100) ? 5.0 : -3.0;
+    double measured = 0.02 * i;
+    EXPECT_NEAR(pidController.compute(setpoint, measured),
+                staticController.compute(setpoint, measured), 1e-9);
+  }
+  EXPECT_NEAR(pidController.get_integral_sum(),
+              staticController.get_integral_sum(), 1e-9);
+}
+
+// To test that compile-time gains give the values of test_compute_works
+TEST(StaticPIDController_Test, fixed_gains_compute_works) {
+  StaticPIDController<double, FixedGains<double, TestGains> > controller;
+  EXPECT_NEAR(11.1, controller.compute(20.0, 10.0), 0.001);
+  EXPECT_NEAR(-11.121, controller.compute(20.0, 21.1), 0.001);
+  static_assert(FixedGains<double, TestGains>::get_kD_over_dt() == 1.0,
+                "kD / dt should be folded at compile time");
+}
+
+// To test that invalid dt is rejected by the runtime gains
+TEST(StaticPIDController_Test, invalid_dt_throws_exception) {
+  typedef StaticPIDController<double> Controller;
+  EXPECT_THROW(Controller(0.1, 0.1, 0.1, 100.0, -100.0, 0),
+               std::invalid_argument);
+  Controller controller(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  EXPECT_THROW(controller.set_dt(-1), std::invalid_argument);
+}
+
+// To test that NoClamp ignores the limits
+TEST(StaticPIDController_Test, no_clamp_ignores_limits) {
+  StaticPIDController<double, RuntimeGains<double>, pid_policy::NoClamp>
+      controller(1, 1, 1, 50.0, -50.0, 0.1);
+  EXPECT_NEAR(111.0, controller.compute(20.0, 10.0), 1e-9);
+}
+
+// To test that conditional integration stops integral_sum from growing
+// while the output is saturated
+TEST(StaticPIDController_Test, conditional_integration_limits_windup) {
+  StaticPIDController<double, RuntimeGains<double>, pid_policy::Clamp,
+                      pid_policy::ConditionalIntegration>
+      controller(1, 1, 0, 5.0, -5.0, 0.1);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(5.0, controller.compute(20.0, 10.0));
+  }
+  EXPECT_EQ(0.0, controller.get_integral_sum());
+
+  // Back inside the limits: integration resumes immediately.
+  EXPECT_NEAR(-2.2, controller.compute(10.0, 12.0), 1e-12);
+  EXPECT_NEAR(-0.2, controller.get_integral_sum(), 1e-12);
+}
+
+// To test that derivative on measurement has no kick on a setpoint step
+TEST(StaticPIDController_Test, derivative_on_measurement_no_setpoint_kick) {
+  StaticPIDController<double, RuntimeGains<double>, pid_policy::NoClamp,
+                      pid_policy::NoAntiWindup,
+                      pid_policy::DerivativeOnMeasurement>
+      controller(0, 0, 1, 0, 0, 0.1);
+  controller.compute(0.0, 1.0);
+  EXPECT_EQ(0.0, controller.compute(100.0, 1.0));
+  EXPECT_NEAR(-10.0, controller.compute(100.0, 2.0), 1e-9);
+}
+
+// To test that the first sample seeds the measurement history, after
+// construction and after reset(), so it has no derivative term
+TEST(StaticPIDController_Test, derivative_on_measurement_first_sample) {
+  StaticPIDController<double, RuntimeGains<double>, pid_policy::NoClamp,
+                      pid_policy::NoAntiWindup,
+                      pid_policy::DerivativeOnMeasurement>
+      controller(2, 0, 1, 0, 0, 0.1);
+  EXPECT_EQ(2 * (5.0 - 3.0), controller.compute(5.0, 3.0));
+  EXPECT_EQ(-3.0, controller.get_prev_signal());
+  EXPECT_NEAR(2 * (5.0 - 4.0) - 10.0, controller.compute(5.0, 4.0), 1e-9);
+  controller.reset();
+  EXPECT_EQ(2 * (5.0 - 7.0), controller.compute(5.0, 7.0));
+
+  // Derivative on error keeps PIDController's first-sample behaviour.
+  StaticPIDController<double> on_error(2, 0, 1, 100, -100, 0.1);
+  PIDController reference(2, 0, 1, 100, -100, 0.1);
+  EXPECT_EQ(reference.compute(5.0, 3.0), on_error.compute(5.0, 3.0));
+}
+
+// To test that the adapter works through PIDControllerInterface
+TEST(StaticPIDController_Test, adapter_works_through_interface) {
+  typedef StaticPIDController<float, FixedGains<float, TestGains> >
+      Controller;
+  std::unique_ptr<PIDControllerInterface> pidController(
+      new StaticPIDControllerAdapter<Controller>());
+  EXPECT_NEAR(11.1, pidController->compute(20.0, 10.0), 0.001);
+}
@@ -0,0 +1,181 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <pid.hpp>
+#include <spsc_ring.hpp>
+#include <telemetry.hpp>
+
+// To test that the ring buffer capacity is rounded up to a power of two
+// and that a zero capacity is rejected
+TEST(SpscRingBuffer_Test, capacity_rounded_to_power_of_two) {
+  SpscRingBuffer<int> ring(5);
+  EXPECT_EQ(8u, ring.capacity());
+  EXPECT_THROW(SpscRingBuffer<int>(0), std::invalid_argument);
+}
+
+// To test that pushes into a full buffer are dropped and counted
+TEST(SpscRingBuffer_Test, push_into_full_buffer_is_dropped) {
+  SpscRingBuffer<int> ring(4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.try_push(i));
+  }
+  EXPECT_FALSE(ring.try_push(4));
+  EXPECT_EQ(1u, ring.get_dropped());
+
+  int value = -1;
+  EXPECT_TRUE(ring.try_pop(&value));
+  EXPECT_EQ(0, value);
+  EXPECT_TRUE(ring.try_push(4));
+  EXPECT_EQ(4u, ring.size());
+}
+
+// To test that elements cross threads in order and none are lost
+TEST(SpscRingBuffer_Test, producer_consumer_preserves_order) {
+  const int count = 10000;
+  SpscRingBuffer<int> ring(64);
+  std::thread producer([&ring]() {
+    for (int i = 0; i < count; ++i) {
+      while (!ring.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0;
+  int batch[16];
+  while (expected < count) {
+    std::size_t n = ring.pop_batch(batch, 16);
+    if (n == 0) {
+      std::this_thread::yield();
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(expected, batch[i]);
+      ++expected;
+    }
+  }
+  producer.join();
+  EXPECT_EQ(0u, ring.size());
+}
+
+// To test that compute() publishes one record per call with the terms
+// that make up the output
+TEST(Telemetry_Test, compute_publishes_record) {
+  TelemetryRingBuffer sink(16);
+  PIDController pidController(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  pidController.set_telemetry_sink(&sink);
+  EXPECT_EQ(&sink, pidController.get_telemetry_sink());
+
+  double output = pidController.compute(20.0, 10.0);
+
+  TelemetryRecord record;
+  ASSERT_TRUE(sink.try_pop(&record));
+  EXPECT_EQ(20.0, record.setpoint);
+  EXPECT_EQ(10.0, record.measured);
+  EXPECT_EQ(10.0, record.error);
+  EXPECT_EQ(output, record.output);
+  EXPECT_NEAR(output,
+              record.proportional + record.integral + record.derivative,
+              1e-12);
+  EXPECT_EQ(0, record.saturated);
+  EXPECT_FALSE(sink.try_pop(&record));
+}
+
+// To test that a clamped output is flagged and that a detached controller
+// stops publishing
+TEST(Telemetry_Test, saturation_flag_and_detach) {
+  TelemetryRingBuffer sink(16);
+  PIDController pidController(1, 1, 1, 50.0, -50.0, 0.1);
+  pidController.set_telemetry_sink(&sink);
+  pidController.compute(20.0, 10.0);
+  pidController.compute(-20.0, 10.0);
+
+  TelemetryRecord record;
+  ASSERT_TRUE(sink.try_pop(&record));
+  EXPECT_EQ(1, record.saturated);
+  EXPECT_EQ(50.0, record.output);
+  ASSERT_TRUE(sink.try_pop(&record));
+  EXPECT_EQ(-1, record.saturated);
+  EXPECT_EQ(-50.0, record.output);
+
+  pidController.set_telemetry_sink(nullptr);
+  pidController.compute(20.0, 10.0);
+  EXPECT_EQ(0u, sink.size());
+}
+
+// To test that the drainer writes a csv header and one line per record
+TEST(Telemetry_Test, drainer_writes_csv) {
+  TelemetryRingBuffer sink(16);
+  std::ostringstream out;
+  TelemetryDrainer drainer(&sink, &out, TelemetryFormat::csv);
+  PIDController pidController(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  pidController.set_telemetry_sink(&sink);
+  pidController.compute(20.0, 10.0);
+  pidController.compute(20.0, 15.0 + 1.0 / 3.0);
+
+  EXPECT_EQ(2u, drainer.drain());
+  EXPECT_EQ(2u, drainer.get_records_written());
+
+  std::istringstream lines(out.str());
+  std::string line;
+  std::string last;
+  int line_count = 0;
+  while (std::getline(lines, line)) {
+    last = line;
+    ++line_count;
+  }
+  EXPECT_EQ(3, line_count);
+  EXPECT_EQ(0u, out.str().find("timestamp_ns,setpoint,measured"));
+  // Values are written with enough digits to read back exactly.
+  std::istringstream fields(last);
+  std::string timestamp, setpoint, measured;
+  std::getline(fields, timestamp, ',');
+  std::getline(fields, setpoint, ',');
+  std::getline(fields, measured, ',');
+  EXPECT_EQ(15.0 + 1.0 / 3.0, std::stod(measured));
+  EXPECT_EQ(6, out.precision());
+}
+
+// To test that the background drainer writes binary records that
+// round-trip, and flushes everything on stop()
+TEST(Telemetry_Test, background_drainer_writes_binary) {
+  TelemetryRingBuffer sink(1024);
+  std::ostringstream out;
+  std::unique_ptr<TelemetryDrainer> drainer(
+      new TelemetryDrainer(&sink, &out, TelemetryFormat::binary,
+                           std::chrono::microseconds(100)));
+  drainer->start();
+
+  PIDController pidController(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  pidController.set_telemetry_sink(&sink);
+  const int ticks = 500;
+  for (int i = 0; i < ticks; ++i) {
+    pidController.compute(20.0, static_cast<double>(i) * 0.01);
+  }
+  drainer->stop();
+
+  EXPECT_EQ(static_cast<uint64_t>(ticks) - sink.get_dropped(),
+            drainer->get_records_written());
+  std::string bytes = out.str();
+  ASSERT_EQ(drainer->get_records_written() * sizeof(TelemetryRecord),
+            bytes.size());
+  TelemetryRecord first;
+  std::memcpy(&first, bytes.data(), sizeof(first));
+  EXPECT_EQ(20.0, first.setpoint);
+  EXPECT_EQ(0.0, first.measured);
+}
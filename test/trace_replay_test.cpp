@@ -0,0 +1,234 @@
+/** Copyright 2021 Anubhav Paras, Charu Sharma, Arunava Basu & Shon Cortes
+ *  @Authors
+ *  Part 1: Design:
+ *  - Driver: Anubhav Paras
+ *  - Navigator: Charu Sharma
+ *
+ *  Part 2: Implementation:
+ *  - Driver: Shon Cortes
+ *  - Navigator: Arunava Basu
+*/
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mapped_file.hpp>
+#include <parallel.hpp>
+#include <pid.hpp>
+#include <trace_replay.hpp>
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+  return "/tmp/pid_trace_test_" + std::to_string(getpid()) + "_" + name;
+}
+
+GainSet make_gains(double kP, double kI, double kD) {
+  GainSet gains = {kP, kI, kD, 100.0, -100.0, 0.1};
+  return gains;
+}
+
+std::vector<TraceSample> make_samples(std::size_t count) {
+  std::vector<TraceSample> samples(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    samples[i].timestamp = 0.1 * static_cast<double>(i);
+    samples[i].setpoint = (i < count / 2) ? 20.0 : -5.0;
+    samples[i].measured = static_cast<double>(i % 17);
+  }
+  return samples;
+}
+
+// Reads a binary replay output: header then rows of 1 + columns doubles.
+std::vector<double> read_binary_output(const std::string& path,
+                                       uint32_t* columns) {
+  MappedFile file(path);
+  TraceHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  EXPECT_EQ(0, std::memcmp(header.magic, "PIDOUTPT", 8));
+  *columns = header.columns;
+  std::vector<double> values((file.size() - sizeof(header)) /
+                             sizeof(double));
+  std::memcpy(values.data(), file.data() + sizeof(header),
+              values.size() * sizeof(double));
+  return values;
+}
+
+}  // namespace
+
+// To test that replaying a binary trace gives the same outputs as feeding
+// the samples to a PIDController directly
+TEST(TraceReplay_Test, binary_replay_matches_pid_controller) {
+  std::string input = temp_path("in.bin"), output = temp_path("out.bin");
+  std::vector<TraceSample> samples = make_samples(100);
+  write_binary_trace(input, samples);
+
+  TraceReplayer replayer({make_gains(0.1, 0.1, 0.1)});
+  EXPECT_EQ(100u, replayer.replay(input, output, TraceFormat::binary));
+
+  uint32_t columns = 0;
+  std::vector<double> values = read_binary_output(output, &columns);
+  ASSERT_EQ(2u, columns);
+  ASSERT_EQ(200u, values.size());
+  PIDController pidController(0.1, 0.1, 0.1, 100.0, -100.0, 0.1);
+  for (std::size_t i = 0; i < samples.size(); ++i) {
+    EXPECT_EQ(samples[i].timestamp, values[2 * i]);
+    const double step = i == 0 ? 0.1
+                               : samples[i].timestamp -
+                                     samples[i - 1].timestamp;
+    EXPECT_EQ(pidController.compute_with_dt(samples[i].setpoint,
+                                            samples[i].measured, step),
+              values[2 * i + 1]);
+  }
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+}
+
+// To test that several gain sets are replayed side by side from a csv
+// trace with a header line
+TEST(TraceReplay_Test, csv_replay_with_several_gain_sets) {
+  std::string input = temp_path("in.csv"), output = temp_path("out.csv");
+  {
+    std::ofstream out(input.c_str());
+    out << "timestamp,setpoint,measured\n0,20,10\n0.1, 20 ,21.1\r\n\n";
+  }
+
+  std::vector<TraceSample> samples = read_trace(input);
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ(0.1, samples[1].timestamp);
+  EXPECT_EQ(21.1, samples[1].measured);
+
+  TraceReplayer replayer({make_gains(0.1, 0.1, 0.1), make_gains(1, 1, 1)});
+  EXPECT_EQ(2u, replayer.get_gain_set_count());
+  EXPECT_EQ(2u, replayer.replay(input, output, TraceFormat::csv));
+
+  std::ifstream in(output.c_str());
+  std::string line;
+  std::getline(in, line);
+  EXPECT_EQ("timestamp,output_0,output_1", line);
+  double timestamp, first, second;
+  char comma;
+  in >> timestamp >> comma >> first >> comma >> second;
+  EXPECT_NEAR(11.1, first, 0.001);
+  EXPECT_EQ(100.0, second);
+  in >> timestamp >> comma >> first >> comma >> second;
+  EXPECT_NEAR(0.1, timestamp, 1e-12);
+  EXPECT_NEAR(-11.121, first, 0.001);
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+}
+
+// To test that irregularly spaced samples step by their own spacing, the
+// same way with one gain set and with several
+TEST(TraceReplay_Test, irregular_timestamps_use_elapsed_time) {
+  std::string input = temp_path("irregular.bin");
+  std::string bank_output = temp_path("irregular_bank.bin");
+  std::string single_output = temp_path("irregular_single.bin");
+  std::vector<TraceSample> samples = make_samples(50);
+  double timestamp = 0;
+  for (std::size_t i = 0; i < samples.size(); ++i) {
+    samples[i].timestamp = timestamp;
+    timestamp += 0.01 * static_cast<double>(i % 4 + 1);
+  }
+  write_binary_trace(input, samples);
+
+  GainSet first = make_gains(0.5, 0.2, 0.1);
+  GainSet second = make_gains(1, 1, 1);
+  second.dt = 0.02;
+  TraceReplayer({first, second}).replay(input, bank_output,
+                                        TraceFormat::binary);
+  uint32_t columns = 0;
+  std::vector<double> bank = read_binary_output(bank_output, &columns);
+  ASSERT_EQ(3u, columns);
+  const std::size_t rows = samples.size();
+  ASSERT_EQ(3 * rows, bank.size());
+  const GainSet sets[] = {first, second};
+  for (std::size_t j = 0; j < 2; ++j) {
+    TraceReplayer({sets[j]}).replay(input, single_output,
+                                    TraceFormat::binary);
+    std::vector<double> single = read_binary_output(single_output, &columns);
+    ASSERT_EQ(2 * rows, single.size());
+    for (std::size_t i = 0; i < rows; ++i) {
+      EXPECT_EQ(single[2 * i + 1], bank[3 * i + 1 + j]);
+    }
+  }
+  std::remove(input.c_str());
+  std::remove(bank_output.c_str());
+  std::remove(single_output.c_str());
+}
+
+// To test that several logs are replayed in parallel
+TEST(TraceReplay_Test, replay_all_processes_every_log) {
+  std::vector<std::pair<std::string, std::string> > jobs;
+  for (int i = 0; i < 4; ++i) {
+    std::string input = temp_path("job" + std::to_string(i) + ".bin");
+    write_binary_trace(input, make_samples(10 * (i + 1)));
+    jobs.emplace_back(input, input + ".out");
+  }
+
+  TraceReplayer replayer({make_gains(0.1, 0.1, 0.1)});
+  std::vector<uint64_t> counts =
+      replayer.replay_all(jobs, TraceFormat::binary, 3);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(static_cast<uint64_t>(10 * (i + 1)), counts[i]);
+    std::remove(jobs[i].first.c_str());
+    std::remove(jobs[i].second.c_str());
+  }
+}
+
+// To test that missing files, malformed traces and invalid gains throw
+TEST(TraceReplay_Test, invalid_input_throws_exception) {
+  EXPECT_THROW(TraceReplayer(std::vector<GainSet>()), std::invalid_argument);
+  GainSet gains = make_gains(1, 1, 1);
+  gains.dt = 0;
+  EXPECT_THROW(TraceReplayer({gains}), std::invalid_argument);
+
+  TraceReplayer replayer({make_gains(0.1, 0.1, 0.1)});
+  std::string output = temp_path("bad.out");
+  EXPECT_THROW(replayer.replay(temp_path("missing"), output,
+                               TraceFormat::binary),
+               std::runtime_error);
+
+  std::string input = temp_path("bad.csv");
+  {
+    std::ofstream out(input.c_str());
+    out << "0,1,2\n0.1,oops,2\n";
+  }
+  EXPECT_THROW(replayer.replay(input, output, TraceFormat::csv),
+               std::runtime_error);
+  {
+    std::ofstream out(input.c_str());
+    out << "0.2,1,2\n0.1,1,2\n";
+  }
+  EXPECT_THROW(replayer.replay(input, output, TraceFormat::csv),
+               std::runtime_error);
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+}
+
+// To test that parallel_for visits every index once and forwards
+// exceptions
+TEST(TraceReplay_Test, parallel_for_visits_every_index) {
+  std::vector<std::atomic<int> > hits(1000);
+  for (std::atomic<int>& hit : hits) {
+    hit.store(0);
+  }
+  parallel_for(hits.size(), 4, [&hits](std::size_t i) { hits[i]++; });
+  for (std::atomic<int>& hit : hits) {
+    EXPECT_EQ(1, hit.load());
+  }
+  EXPECT_THROW(parallel_for(10, 2, [](std::size_t i) {
+                 if (i == 5) {
+                   throw std::runtime_error("boom");
+                 }
+               }),
+               std::runtime_error);
+}